@@ -0,0 +1,310 @@
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "adjacency.hpp"
+#include "bitboard.hpp"
+#include "board_memory.hpp"
+#include "command.hpp"
+#include "endless.hpp"
+#include "fixed_game.hpp"
+#include "game.hpp"
+#include "protocol.hpp"
+#include "render.hpp"
+
+// benchmarks: every case runs on boards from a fixed seed and prints one json object per line
+namespace bench {
+
+constexpr uint64_t seed = 0x5eed;
+constexpr double min_seconds = 0.25;
+constexpr double max_seconds = 2.0;
+volatile uint64_t sink;
+
+// setup runs untimed before every timed call of op
+template <typename Setup, typename Op>
+void run(const std::string& name, size_t cells_per_op, Setup setup, Op op) {
+	using clock = std::chrono::steady_clock;
+	clock::duration total{};
+	size_t iterations = 0;
+	auto first = clock::now();
+	auto seconds = [](clock::duration d) { return std::chrono::duration<double>(d).count(); };
+	while (iterations < 3 || (seconds(total) < min_seconds && seconds(clock::now() - first) < max_seconds)) {
+		setup();
+		auto start = clock::now();
+		op();
+		total += clock::now() - start;
+		iterations++;
+	}
+
+	double ns_per_op = std::chrono::duration<double, std::nano>(total).count() / iterations;
+	std::cout << "{\"name\": \"" << name << "\", \"iterations\": " << iterations
+		<< ", \"ns_per_op\": " << ns_per_op
+		<< ", \"cells_per_s\": " << cells_per_op * 1e9 / ns_per_op << "}" << std::endl;
+}
+
+template <typename Op>
+void run(const std::string& name, size_t cells_per_op, Op op) {
+	run(name, cells_per_op, [] {}, op);
+}
+
+std::string size_name(size_t m, size_t n) {
+	return std::to_string(m) + "x" + std::to_string(n);
+}
+
+// a board without bombs around (i, j) so that revealing it always cascades
+Game open_board(size_t m, size_t n, float bomb_likelihood, Layout layout = Layout::RowMajor) {
+	Game game(m, n, bomb_likelihood, seed, layout);
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			game.set_bomb(i, j, false);
+		}
+	}
+
+	return game;
+}
+
+void fill_grid() {
+	for (auto [m, n] : std::vector<std::pair<size_t, size_t>>{{9, 9}, {16, 30}, {256, 256}, {1024, 1024}}) {
+		for (float likelihood : {.12f, .2f, .5f}) {
+			run("fill_grid/" + size_name(m, n) + "/" + std::to_string(likelihood).substr(0, 4), m * n, [&] {
+				Game game(m, n, likelihood, seed);
+				sink = game.count_bombs;
+			});
+		}
+	}
+}
+
+void pages() {
+	// a mega-board allocated, generated and opened through each page policy. the name carries the
+	// path the allocation actually took, a kernel without a hugetlb pool falls back to thp or the heap
+	for (PagePolicy policy : {PagePolicy::Default, PagePolicy::Transparent, PagePolicy::Explicit}) {
+		board_pages = policy;
+		size_t size = 4096;
+		Game open = open_board(size, size, 0);
+		std::string name = std::string(page_policy_names[static_cast<size_t>(policy)]) + "/"
+			+ allocation_path_names[static_cast<size_t>(open.grid.storage().path())];
+		run("pages/fill_grid/" + name + "/" + size_name(size, size), size * size, [&] {
+			Game game(size, size, .2f, seed);
+			sink = game.count_bombs;
+		});
+		run("pages/full_cascade/" + name + "/" + size_name(size, size), size * size, [&] { open.restart(); }, [&] {
+			::expand(open, size / 2, size / 2);
+		});
+	}
+	board_pages = PagePolicy::Default;
+}
+
+void count_bomb_neighbors() {
+	Game game(256, 256, .2f, seed);
+	run("count_bomb_neighbors/256x256", 256 * 256, [&] {
+		uint64_t total = 0;
+		for (int i = 0; i < 256; i++) {
+			for (int j = 0; j < 256; j++) {
+				total += ::count_bomb_neighbors(game.grid, i, j);
+			}
+		}
+		sink = total;
+	});
+}
+
+void count_adjacent() {
+	// the whole count plane at once, bitsliced: the portable kernel and whatever the cpu dispatches to
+	for (size_t size : {256, 4096}) {
+		BitPlane plane = bomb_plane(Game(size, size, .2f, seed));
+		CountPlanes counts;
+		run("count_adjacent/scalar/" + size_name(size, size), size * size, [&] {
+			::count_adjacent_scalar(plane, counts);
+			sink = counts.planes[0].words[plane.stride + 1];
+		});
+		run("count_adjacent/" + std::string(adjacency_kernel()) + "/" + size_name(size, size), size * size, [&] {
+			::count_adjacent(plane, counts);
+			sink = counts.planes[0].words[plane.stride + 1];
+		});
+	}
+}
+
+void expand() {
+	// best case: a numbered cell, the cascade stops immediately
+	Game dense(256, 256, .3f, seed);
+	std::pair<int, int> numbered{0, 0};
+	for (int k = 0; k < 256 * 256; k++) {
+		if (dense.grid.at(k / 256, k % 256).type != CellType::BOMB && count_bomb_neighbors(dense.grid, k / 256, k % 256)) {
+			numbered = {k / 256, k % 256};
+			break;
+		}
+	}
+	run("expand/single_cell", 1, [&] { dense.set_hidden(numbered.first, numbered.second); }, [&] {
+		::expand(dense, numbered.first, numbered.second);
+	});
+
+	// worst case: the whole board opens from one click
+	for (size_t size : {64, 256, 1024}) {
+		Game open = open_board(size, size, 0);
+		run("expand/full_cascade/" + size_name(size, size), size * size, [&] { open.restart(); }, [&] {
+			::expand(open, size / 2, size / 2);
+		});
+	}
+
+	// the same cascade through both cell layouts; a tile keeps a cell's vertical neighbours close
+	for (size_t size : {1024, 2048}) {
+		for (Layout layout : {Layout::RowMajor, Layout::Tiled}) {
+			Game open = open_board(size, size, 0, layout);
+			std::string name = layout_names[static_cast<size_t>(layout)];
+			run("expand/full_cascade/" + name + "/" + size_name(size, size), size * size, [&] { open.restart(); }, [&] {
+				::expand(open, size / 2, size / 2);
+			});
+		}
+	}
+}
+
+void restart() {
+	// a played-out board: restart only moves the epoch, so this should not grow with the size
+	for (size_t size : {64, 1024}) {
+		Game game = open_board(size, size, 0);
+		::expand(game, size / 2, size / 2);
+		run("restart/" + size_name(size, size), size * size, [&] {
+			game.restart();
+		});
+	}
+}
+
+void chord() {
+	// every cell of an open board chords, reveal all of them and then chord the centre repeatedly
+	Game game(256, 256, .15f, seed);
+	for (int i = 0; i < 256; i++) {
+		for (int j = 0; j < 256; j++) {
+			if (game.grid.at(i, j).type == CellType::BOMB) {
+				try_set_flag(game, {i, j}, true);
+			} else {
+				game.set_revealed(i, j);
+			}
+		}
+	}
+
+	run("try_reveal/chord", 8, [&] {
+		sink = static_cast<uint64_t>(try_reveal(game, {128, 128}));
+	});
+}
+
+void render() {
+	for (size_t size : {10, 100}) {
+		Game game(size, size, .15f, seed);
+		play_reveal(game, {size / 2, size / 2});
+		std::ostringstream os;
+		run("operator<</" + size_name(size, size), size * size, [&] { os.str(""); }, [&] {
+			os << game;
+		});
+	}
+
+	// a debugging dump of a large finished board, every cell showing its glyph
+	Game game(2048, 2048, .15f, seed);
+	game.state = GameState::OVER;
+	std::ostringstream os;
+	run(std::string("render/ascii/") + render_kernel() + "/2048x2048", 2048 * 2048, [&] { os.str(""); }, [&] {
+		render(os, game, RenderMode::Ascii);
+	});
+}
+
+// reveals pseudo-random cells until the game is over, returns the number of moves
+template <typename G>
+uint64_t play_out(G& game, int m, int n, uint64_t rng) {
+	uint64_t moves = 0;
+	while (game.state != GameState::OVER) {
+		rng = mix64(rng);
+		apply_move(game, Opcode::Reveal, {static_cast<int>(rng % m), static_cast<int>((rng >> 32) % n)});
+		moves++;
+	}
+
+	return moves;
+}
+
+void small_games() {
+	// whole beginner games, created and played out: heap-backed Game, Game on an arena that is
+	// released after every game, inline FixedGame and the register-resident BitGame
+	uint64_t g = 0;
+	run("game/beginner/Game", 81, [&] {
+		Game game(9, 9, .12f, seed + g);
+		sink = play_out(game, 9, 9, seed + g++);
+	});
+
+	g = 0;
+	std::array<std::byte, 1 << 14> backing;
+	std::pmr::monotonic_buffer_resource arena(backing.data(), backing.size());
+	run("game/beginner/Game/arena", 81, [&] {
+		{
+			Game game(9, 9, .12f, seed + g, Layout::RowMajor, &arena);
+			sink = play_out(game, 9, 9, seed + g++);
+		}
+		arena.release();
+	});
+
+	g = 0;
+	run("game/beginner/FixedGame", 81, [&] {
+		BeginnerGame game(.12f, seed + g);
+		sink = play_out(game, 9, 9, seed + g++);
+	});
+
+	g = 0;
+	run("game/beginner/BitGame", 81, [&] {
+		BitGame game(9, 9, .12f, seed + g);
+		sink = play_out(game, 9, 9, seed + g++);
+	});
+}
+
+void endless() {
+	// a cascade on a sparse endless board runs into the limit, materializing chunks all the way
+	EndlessGame sparse(0, seed);
+	run("endless/cascade/" + std::to_string(sparse.cascade_limit), sparse.cascade_limit, [&] { sparse.restart(); }, [&] {
+		apply_move(sparse, Opcode::Reveal, {0, 0});
+		sink = sparse.count_chunks();
+	});
+
+	// whole games within a 256 x 256 window of an unbounded board
+	uint64_t g = 0;
+	run("endless/game/256x256", 256 * 256, [&] {
+		EndlessGame game(.15f, seed + g);
+		sink = play_out(game, 256, 256, seed + g++);
+	});
+}
+
+void to_command() {
+	std::string line = "reveal 1 2 3 4 5 6 7 8 9 10";
+	run("to_command", 5, [&] {
+		sink = ::to_command(line).size();
+	});
+
+	std::array<std::byte, 1024> scratch;
+	run("to_command/arena", 5, [&] {
+		std::pmr::monotonic_buffer_resource arena(scratch.data(), scratch.size());
+		sink = ::to_command(line, &arena).size();
+	});
+}
+
+void run_all() {
+	fill_grid();
+	pages();
+	count_bomb_neighbors();
+	count_adjacent();
+	expand();
+	restart();
+	chord();
+	render();
+	small_games();
+	endless();
+	to_command();
+}
+
+}
+
+int main() {
+	bench::run_all();
+	return 0;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// a fuzz target defines LLVMFuzzerTestOneInput, which libFuzzer drives when the targets are
+// built with MINES_LIBFUZZER, and standalone.cpp drives otherwise. a target aborts when an
+// input breaks one of its checks
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// words of the target's input format, the standalone driver builds its random inputs from them
+extern const std::vector<std::string> fuzz_dictionary;
@@ -0,0 +1,70 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "command.hpp"
+#include "console.hpp"
+#include "fuzz.hpp"
+#include "game.hpp"
+#include "journal.hpp"
+
+// typed input: the first byte picks the seed and topology of a small game, the rest are lines
+// that go through to_command and the interactive command table, parse_places included. the
+// commands that name a file are skipped, they would read and write wherever the input says
+namespace {
+
+bool names_a_file(std::string_view word) {
+	return word == "save" || word == "load" || word == "dump";
+}
+
+}
+
+// commands start their line, so that most random inputs run a few of them
+const std::vector<std::string> fuzz_dictionary{
+	"\nreveal ", "\nreveal ", "\nflag ", "\nunflag ", "\nrestart", "\nundo", "\nredo", "\nhelp",
+	"\nbombs_left?", "\nmemory", "\nexit", "\nsave x", "\nreveal", "\nfoo ",
+	"0 ", "1 ", "2 ", "4 ", "7 ", "8 ", "9 ", "3 5 ", "-1 ", "12 ", "2147483647 ", "-2147483648 ",
+	"99999999999 ", "+1 ", "0x1 ", "1.5 ", " ", "\t", "\n", "\r\n",
+};
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	if (!size) {
+		return 0;
+	}
+
+	// the commands report to std::cout, which is silenced while fuzzing
+	std::cout.setstate(std::ios::badbit);
+
+	Journal journal(1 << 16);
+	Game game(8, 9, .15f, data[0]);
+	game.set_topology(static_cast<Topology>(data[0] % 3));
+	game.journal = &journal;
+
+	std::string_view input(reinterpret_cast<const char*>(data) + 1, size - 1);
+	while (!input.empty() && game.state != GameState::OVER) {
+		size_t end = std::min(input.find('\n'), input.size());
+		Command command = to_command(input.substr(0, end));
+		input.remove_prefix(std::min(end + 1, input.size()));
+		if (command.empty() || names_a_file(command.front())) {
+			continue;
+		}
+
+		auto option = command_table.find(std::string_view(command.front()));
+		if (option != command_table.end()) {
+			option->second(game, command);
+		}
+
+		if (!counters_consistent(game)) {
+			std::abort();
+		}
+	}
+
+	std::ostringstream board;
+	board << game;
+	return 0;
+}
@@ -0,0 +1,51 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fuzz.hpp"
+#include "game.hpp"
+#include "journal.hpp"
+#include "protocol.hpp"
+
+// binary input: the bytes are served as move frames to a small game with a journal, and every
+// frame decode_move accepts must decode to the same move again once encode_move wrote it back
+const std::vector<std::string> fuzz_dictionary{
+	std::string(1, '\0'), "\x01", "\x02", "\x03", "\x04", "\x05", "\x06", "\x07", "\x08", "\xff",
+	std::string(1, '\0'), "\x01", "\x03", "\x07", "\x08", "\x7f", "\x80\x01", std::string("\x80\x00", 2),
+	"\xff\xff\xff\xff\x0f", "\xff\xff\xff\xff\xff",
+};
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	std::string bytes(reinterpret_cast<const char*>(data), size);
+
+	Journal journal(1 << 16);
+	Game game(8, 9, .15f, 7);
+	game.journal = &journal;
+	std::istringstream in(bytes);
+	std::ostringstream out;
+	serve_binary(game, in, out);
+	if (!counters_consistent(game)) {
+		std::abort();
+	}
+
+	std::istringstream frames(bytes);
+	Opcode op;
+	std::pair<int, int> place;
+	while (decode_move(frames, op, place)) {
+		std::string encoded;
+		encode_move(encoded, op, place);
+
+		std::istringstream again(encoded);
+		Opcode decoded_op;
+		std::pair<int, int> decoded_place;
+		if (!decode_move(again, decoded_op, decoded_place) || decoded_op != op || decoded_place != place) {
+			std::abort();
+		}
+	}
+
+	return 0;
+}
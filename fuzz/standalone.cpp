@@ -0,0 +1,103 @@
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "fuzz.hpp"
+#include "game.hpp"
+
+// runs a fuzz target without libFuzzer, on every file named on the command line or else on
+// --runs random inputs drawn from --seed. an input is a run of dictionary words and random bytes,
+// so that most of them get past the target's parser. when an input aborts it is written to
+// crash-<seed> first, sanitizer reports included with ASAN_OPTIONS=abort_on_error=1
+namespace {
+
+std::string current;
+char crash_path[32];
+
+void save_current(int) {
+	int fd = open(crash_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd >= 0) {
+		[[maybe_unused]] ssize_t written = write(fd, current.data(), current.size());
+		close(fd);
+	}
+
+	signal(SIGABRT, SIG_DFL);
+	raise(SIGABRT);
+}
+
+std::string random_input(uint64_t& rng) {
+	std::string input;
+	rng = mix64(rng);
+	size_t pieces = rng % 64;
+	for (size_t k = 0; k < pieces; k++) {
+		rng = mix64(rng);
+		if (rng % 4) {
+			input += fuzz_dictionary[(rng >> 8) % fuzz_dictionary.size()];
+			continue;
+		}
+
+		for (size_t b = 0; b < 1 + (rng >> 8) % 4; b++) {
+			input.push_back(static_cast<char>(rng >> (16 + 8 * b)));
+		}
+	}
+
+	return input;
+}
+
+int run(const std::string& input) {
+	return LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+}
+
+}
+
+int main(int argc, char** argv) {
+	uint64_t runs = 100000;
+	uint64_t seed = 1;
+	std::vector<std::string> paths;
+	for (int k = 1; k < argc; k++) {
+		std::string arg = argv[k];
+		if (arg == "--runs" && k + 1 < argc) {
+			runs = std::stoull(argv[++k]);
+		} else if (arg == "--seed" && k + 1 < argc) {
+			seed = std::stoull(argv[++k]);
+		} else {
+			paths.push_back(arg);
+		}
+	}
+
+	for (auto& path : paths) {
+		std::ifstream in(path, std::ios::binary);
+		if (!in) {
+			std::cerr << "Failed reading \"" << path << "\".\n";
+			return 1;
+		}
+
+		run(std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()));
+	}
+
+	if (!paths.empty()) {
+		std::cerr << "Ran " << paths.size() << " inputs.\n";
+		return 0;
+	}
+
+	std::snprintf(crash_path, sizeof(crash_path), "crash-%llu", static_cast<unsigned long long>(seed));
+	signal(SIGABRT, save_current);
+
+	uint64_t rng = seed;
+	for (uint64_t r = 0; r < runs; r++) {
+		current = random_input(rng);
+		run(current);
+	}
+
+	std::cerr << "Ran " << runs << " random inputs from seed " << seed << ".\n";
+	return 0;
+}
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Builds a baseline and a profile-guided binary, training the latter on headless auto-play
+# of every preset, then runs the simulator and the benchmarks against both.
+#
+# usage: scripts/pgo.sh [build-dir]    (MINES_PGO_GAMES sets the games per preset, default 500)
+set -eu
+
+src=$(cd "$(dirname "$0")/.." && pwd)
+out=${1:-"$src/build"}
+games=${MINES_PGO_GAMES:-500}
+jobs=$(nproc 2>/dev/null || echo 1)
+profiles="$out/pgo/pgo-profiles"
+
+cmake -S "$src" -B "$out/baseline" -DMINES_PGO=OFF
+cmake --build "$out/baseline" -j "$jobs"
+
+# the profiles name the object files they belong to, so GENERATE and USE share one build directory
+rm -rf "$profiles"
+cmake -S "$src" -B "$out/pgo" -DMINES_PGO=GENERATE -DMINES_PGO_DIR="$profiles"
+cmake --build "$out/pgo" -j "$jobs"
+"$out/pgo/mines" --simulate "$games" --seed 1 > /dev/null
+
+if ls "$profiles"/*.profraw > /dev/null 2>&1; then
+	llvm-profdata merge -o "$profiles/default.profdata" "$profiles"/*.profraw
+fi
+
+cmake -S "$src" -B "$out/pgo" -DMINES_PGO=USE -DMINES_PGO_DIR="$profiles"
+cmake --build "$out/pgo" -j "$jobs"
+
+for variant in baseline pgo; do
+	echo "== $variant"
+	"$out/$variant/mines" --simulate "$games" --seed 2
+	"$out/$variant/mines_bench" > "$out/$variant/bench.json"
+	echo "benchmarks written to $out/$variant/bench.json"
+done
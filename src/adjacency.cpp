@@ -0,0 +1,140 @@
+#include "adjacency.hpp"
+
+#include <cstring>
+
+namespace {
+
+// a gcc vector of four words, one avx2 register
+typedef uint64_t u64x4 __attribute__((vector_size(32)));
+
+// out parameters rather than return values, so no function passes a vector by value
+template <typename V>
+[[gnu::always_inline]] inline void load(V& v, const uint64_t* p) {
+	std::memcpy(&v, p, sizeof(v));
+}
+
+template <typename V>
+[[gnu::always_inline]] inline void store(uint64_t* p, const V& v) {
+	std::memcpy(p, &v, sizeof(v));
+}
+
+template <typename V>
+[[gnu::always_inline]] inline void full_add(const V& a, const V& b, const V& c, V& sum, V& carry) {
+	V t = a ^ b;
+	sum = t ^ c;
+	carry = (a & b) | (t & c);
+}
+
+// the words at w of row r shifted so each bit sees its left and right neighbour; the carry
+// across words comes from the neighbouring words, which the guard words make safe to read
+template <typename V>
+[[gnu::always_inline]] inline void sides(const uint64_t* r, size_t w, V& left, V& right) {
+	V here, before, after;
+	load(here, r + w);
+	load(before, r + w - 1);
+	load(after, r + w + 1);
+	left = (here << 1) | (before >> 63);
+	right = (here >> 1) | (after << 63);
+}
+
+template <typename V>
+[[gnu::always_inline]] inline void count_rows(const BitPlane& plane, CountPlanes& counts) {
+	constexpr size_t lanes = sizeof(V) / sizeof(uint64_t);
+	for (size_t i = 0; i < plane.m; i++) {
+		const uint64_t* up = plane.row(i) - plane.stride;
+		const uint64_t* cur = plane.row(i);
+		const uint64_t* down = plane.row(i) + plane.stride;
+		uint64_t* out[4] = {counts.planes[0].row(i), counts.planes[1].row(i), counts.planes[2].row(i), counts.planes[3].row(i)};
+
+		for (size_t w = 0; w < plane.words_per_row; w += lanes) {
+			V in[8];
+			sides(up, w, in[0], in[1]);
+			sides(cur, w, in[2], in[3]);
+			sides(down, w, in[4], in[5]);
+			load(in[6], up + w);
+			load(in[7], down + w);
+
+			// ones from three full adders and a half adder, then the twos and the fours
+			V s1, c1, s2, c2, s3, c3, ones, c4, t1, d1, twos, d2;
+			full_add(in[0], in[1], in[2], s1, c1);
+			full_add(in[3], in[4], in[5], s2, c2);
+			s3 = in[6] ^ in[7];
+			c3 = in[6] & in[7];
+			full_add(s1, s2, s3, ones, c4);
+			full_add(c1, c2, c3, t1, d1);
+			twos = t1 ^ c4;
+			d2 = t1 & c4;
+
+			store(out[0] + w, ones);
+			store(out[1] + w, twos);
+			store(out[2] + w, d1 ^ d2);
+			store(out[3] + w, d1 & d2);
+		}
+
+		// the cell past the last column picked up a count from it
+		if (plane.n % 64) {
+			uint64_t valid = (uint64_t(1) << (plane.n % 64)) - 1;
+			for (uint64_t* row : out) {
+				row[plane.n / 64] &= valid;
+			}
+		}
+	}
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) void count_adjacent_avx2(const BitPlane& plane, CountPlanes& counts) {
+	count_rows<u64x4>(plane, counts);
+}
+
+bool has_avx2() {
+	static const bool result = __builtin_cpu_supports("avx2");
+	return result;
+}
+#else
+bool has_avx2() {
+	return false;
+}
+#endif
+
+void prepare(const BitPlane& plane, CountPlanes& counts) {
+	for (auto& out : counts.planes) {
+		if (out.m != plane.m || out.n != plane.n) {
+			out = BitPlane(plane.m, plane.n, out.words.get_allocator().resource());
+		}
+	}
+}
+
+}
+
+BitPlane bomb_plane(const Game& game, std::pmr::memory_resource* resource) {
+	BitPlane plane(game.grid.rows(), game.grid.cols(), resource);
+	for (size_t i = 0; i < plane.m; i++) {
+		uint64_t* row = plane.row(i);
+		for (size_t j = 0; j < plane.n; j++) {
+			row[j / 64] |= uint64_t(game.grid.at(i, j).type == CellType::BOMB) << (j % 64);
+		}
+	}
+
+	return plane;
+}
+
+void count_adjacent_scalar(const BitPlane& plane, CountPlanes& counts) {
+	prepare(plane, counts);
+	count_rows<uint64_t>(plane, counts);
+}
+
+void count_adjacent(const BitPlane& plane, CountPlanes& counts) {
+#if defined(__x86_64__) || defined(__i386__)
+	if (has_avx2()) {
+		prepare(plane, counts);
+		count_adjacent_avx2(plane, counts);
+		return;
+	}
+#endif
+
+	count_adjacent_scalar(plane, counts);
+}
+
+const char* adjacency_kernel() {
+	return has_avx2() ? "avx2" : "scalar";
+}
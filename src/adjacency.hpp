@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "game.hpp"
+
+// one bit per cell of an m x n board. rows are padded to a multiple of four words and framed by
+// a zero guard word on either side and a zero guard row above and below, so the kernels can
+// read every neighbour word of a row without bounds checks. bits past column n stay zero.
+// the words come from resource, so that a caller drawing planes every frame can keep them off the heap
+struct BitPlane {
+	size_t m = 0;
+	size_t n = 0;
+	size_t words_per_row = 0;
+	size_t stride = 0;
+	std::pmr::vector<uint64_t> words;
+
+	BitPlane() = default;
+
+	explicit BitPlane(std::pmr::memory_resource* resource)
+		: words(resource) {}
+
+	BitPlane(size_t m, size_t n, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: m(m), n(n), words_per_row((n + 255) / 256 * 4), stride(words_per_row + 2), words((m + 2) * stride, resource) {}
+
+	uint64_t* row(size_t i) {
+		return words.data() + (i + 1) * stride + 1;
+	}
+
+	const uint64_t* row(size_t i) const {
+		return words.data() + (i + 1) * stride + 1;
+	}
+
+	bool test(size_t i, size_t j) const {
+		return row(i)[j / 64] >> (j % 64) & 1;
+	}
+
+	void set(size_t i, size_t j) {
+		row(i)[j / 64] |= uint64_t(1) << (j % 64);
+	}
+};
+
+// every cell's count of set 8-neighbours, bitsliced: bit b of the count of (i, j) is
+// planes[b].test(i, j). the kernels size the planes from resource
+struct CountPlanes {
+	BitPlane planes[4];
+
+	CountPlanes() = default;
+
+	explicit CountPlanes(std::pmr::memory_resource* resource)
+		: planes{BitPlane(resource), BitPlane(resource), BitPlane(resource), BitPlane(resource)} {}
+
+	uint32_t count(size_t i, size_t j) const {
+		return planes[0].test(i, j) | planes[1].test(i, j) << 1 | planes[2].test(i, j) << 2 | planes[3].test(i, j) << 3;
+	}
+};
+
+BitPlane bomb_plane(const Game& game, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// sums the eight shifted copies of plane with bitsliced full adders, 64 cells per word, or
+// 256 per step with avx2 when the cpu has it
+void count_adjacent(const BitPlane& plane, CountPlanes& counts);
+
+void count_adjacent_scalar(const BitPlane& plane, CountPlanes& counts);
+
+// "avx2" or "scalar", whichever count_adjacent dispatches to on this cpu
+const char* adjacency_kernel();
@@ -0,0 +1,147 @@
+#include "bitboard.hpp"
+
+#include <cassert>
+
+#include "rules.hpp"
+
+BitGame::BitGame(int m, int n, float bomb_likelihood, uint64_t seed)
+	: m(m), n(n), seed(seed), bomb_likelihood(bomb_likelihood)
+{
+	assert(static_cast<size_t>(m * n) <= max_cells);
+	board = (m * n == 128) ? ~Bits(0) : bit(m * n) - 1;
+
+	Bits first_column = 0;
+	for (int i = 0; i < m; i++) {
+		first_column |= bit(i * n);
+	}
+	has_left = board & ~first_column;
+	has_right = board & ~(first_column << (n - 1));
+
+	fill_grid();
+}
+
+void BitGame::fill_grid() {
+	bombs = 0;
+	flags = 0;
+	revealed = 0;
+	last_revealed = 0;
+	for (int k = 0; k < m * n; k++) {
+		bombs |= Bits(is_bomb_at(seed, k, bomb_likelihood)) << k;
+	}
+
+	count_adjacent(bombs, bomb_counts);
+}
+
+void BitGame::new_board(uint64_t board_seed) {
+	seed = board_seed;
+	first_move = true;
+	state = GameState::ACTIVE;
+	fill_grid();
+}
+
+void BitGame::restart() {
+	first_move = true;
+	state = GameState::ACTIVE;
+	flags = 0;
+	revealed = 0;
+	last_revealed = 0;
+}
+
+BitGame::Bits BitGame::adjacent8(Bits bits) const {
+	Bits result = 0;
+	for_each_neighbor<dir8>(0, 0, [&](int di, int dj) {
+		result |= at_offset(bits, di, dj);
+	});
+
+	return result;
+}
+
+BitGame::Bits BitGame::adjacent4(Bits bits) const {
+	Bits result = 0;
+	for_each_neighbor<dir4>(0, 0, [&](int di, int dj) {
+		result |= at_offset(bits, di, dj);
+	});
+
+	return result;
+}
+
+void BitGame::count_adjacent(Bits bits, Bits (&counts)[4]) const {
+	counts[0] = counts[1] = counts[2] = counts[3] = 0;
+	// ripple-carry add each neighbour plane into the counters
+	for_each_neighbor<dir8>(0, 0, [&](int di, int dj) {
+		Bits carry = at_offset(bits, di, dj);
+		for (Bits& count : counts) {
+			Bits next = count & carry;
+			count ^= carry;
+			carry = next;
+		}
+	});
+}
+
+void BitGame::set_bomb(int i, int j, bool value) {
+	if (test(bombs, i, j) == value) {
+		return;
+	}
+
+	bombs ^= bit(i * n + j);
+	count_adjacent(bombs, bomb_counts);
+}
+
+void expand(BitGame& game, BitGame::Bits seeds) {
+	using Bits = BitGame::Bits;
+
+	// cells whose flagged count equals their bomb count, the cascade continues through them.
+	// without flags that is just the cells with no bombs around
+	Bits differ = 0;
+	if (game.flags) {
+		Bits flag_counts[4];
+		game.count_adjacent(game.flags, flag_counts);
+		for (int b = 0; b < 4; b++) {
+			differ |= flag_counts[b] ^ game.bomb_counts[b];
+		}
+	} else {
+		for (Bits count : game.bomb_counts) {
+			differ |= count;
+		}
+	}
+	Bits open = game.board & ~differ;
+
+	Bits closed = game.bombs | game.flags;
+	Bits frontier = seeds & game.board & ~closed & ~game.revealed;
+	[[maybe_unused]] int revealed_before = popcount(game.last_revealed);
+	if (!frontier) {
+		return;
+	}
+
+	while (frontier) {
+		MINES_COUNT(ExpandVisits, popcount(frontier));
+		game.revealed |= frontier;
+		game.last_revealed |= frontier;
+		frontier = game.adjacent4(frontier & open) & ~closed & ~game.revealed;
+	}
+
+	MINES_COUNT(RevealedCells, popcount(game.last_revealed) - revealed_before);
+	MINES_COUNT(Cascades, 1);
+}
+
+void expand(BitGame& game, int i, int j) {
+	if (!game.outside(i, j)) {
+		expand(game, BitGame::bit(i * game.n + j));
+	}
+}
+
+PlayerMove try_reveal(BitGame& game, const std::pair<int, int>& place) {
+	return rules::try_reveal(game, place);
+}
+
+PlayerMove try_set_flag(BitGame& game, const std::pair<int, int>& place, bool value) {
+	return rules::try_set_flag(game, place, value);
+}
+
+PlayerMove play_reveal(BitGame& game, const std::pair<int, int>& place) {
+	return rules::play_reveal(game, place);
+}
+
+PlayerMove apply_move(BitGame& game, Opcode op, const std::pair<int, int>& place) {
+	return rules::apply_move(game, op, place);
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "game.hpp"
+#include "protocol.hpp"
+
+// a rectangle board of at most 128 cells held in registers: the bombs, flags and revealed cells
+// are 128-bit planes, bit i * n + j being the cell (i, j). neighbourhoods are shifts and masks of
+// whole planes, the bomb and flag counts of every cell are added up bitsliced, and a cascade
+// floods a whole frontier per step. the moves are the rules of rules.hpp, and the same seed draws
+// the same board.
+struct BitGame {
+	using Bits = unsigned __int128;
+	static constexpr size_t max_cells = 128;
+
+	int m;
+	int n;
+	uint64_t seed;
+	float bomb_likelihood;
+	bool first_move = true;
+	GameState state = GameState::ACTIVE;
+
+	Bits board;
+	Bits bombs = 0;
+	Bits flags = 0;
+	Bits revealed = 0;
+	// the cells revealed by the last try_reveal
+	Bits last_revealed = 0;
+	// cells that have a neighbour to their left and to their right
+	Bits has_left;
+	Bits has_right;
+	// bomb-neighbour counts as bit planes, bomb_counts[b] holding bit b of every cell's count
+	Bits bomb_counts[4];
+
+	BitGame(int m, int n, float bomb_likelihood, uint64_t seed);
+
+	void fill_grid();
+	void new_board(uint64_t board_seed);
+	void restart();
+
+	static Bits bit(int k) {
+		return Bits(1) << k;
+	}
+
+	bool outside(int i, int j) const {
+		return i < 0 || j < 0 || i >= m || j >= n;
+	}
+
+	bool test(Bits plane, int i, int j) const {
+		return plane >> (i * n + j) & 1;
+	}
+
+	bool is_bomb(int i, int j) const {
+		return test(bombs, i, j);
+	}
+
+	bool is_flagged(int i, int j) const {
+		return test(flags, i, j);
+	}
+
+	bool is_revealed(int i, int j) const {
+		return test(revealed, i, j);
+	}
+
+	void set_flagged(int i, int j, bool value) {
+		flags = value ? flags | bit(i * n + j) : flags & ~bit(i * n + j);
+	}
+
+	void set_revealed(int i, int j) {
+		revealed |= bit(i * n + j);
+	}
+
+	void clear_last_revealed() {
+		last_revealed = 0;
+	}
+
+	void add_last_revealed(int i, int j) {
+		last_revealed |= bit(i * n + j);
+	}
+
+	// the plane of cells whose neighbour (di, dj) away is set in bits
+	Bits at_offset(Bits bits, int di, int dj) const {
+		int d = di * n + dj;
+		if (d >= 128 || d <= -128) {
+			return 0;
+		}
+
+		Bits shifted = d >= 0 ? bits >> d : bits << -d;
+		return shifted & (dj > 0 ? has_right : dj < 0 ? has_left : board);
+	}
+
+	// the cells with at least one 8- or 4-neighbour in bits
+	Bits adjacent8(Bits bits) const;
+	Bits adjacent4(Bits bits) const;
+
+	// bitsliced count of the 8-neighbours set in bits, for every cell at once
+	void count_adjacent(Bits bits, Bits (&counts)[4]) const;
+
+	void set_bomb(int i, int j, bool value);
+};
+
+inline int popcount(BitGame::Bits bits) {
+	return __builtin_popcountll(static_cast<uint64_t>(bits)) + __builtin_popcountll(static_cast<uint64_t>(bits >> 64));
+}
+
+inline uint32_t count_bombs(const BitGame& game) {
+	return popcount(game.bombs);
+}
+
+inline uint32_t count_revealed(const BitGame& game) {
+	return popcount(game.revealed & ~game.bombs);
+}
+
+inline bool is_won(const BitGame& game) {
+	return !(game.board & ~game.bombs & ~game.revealed);
+}
+
+inline uint32_t count_bomb_neighbors(const BitGame& game, int i, int j) {
+	return popcount(game.bombs & game.adjacent8(BitGame::bit(i * game.n + j)));
+}
+
+inline uint32_t count_flagged_neighbors(const BitGame& game, int i, int j) {
+	return popcount(game.flags & game.adjacent8(BitGame::bit(i * game.n + j)));
+}
+
+template <typename F>
+void for_each_adjacent(const BitGame& game, int i, int j, F f) {
+	for_each_neighbor<dir8>(i, j, [&](int a, int b) {
+		if (!game.outside(a, b)) {
+			f(a, b);
+		}
+	});
+}
+
+// reveals the cells of seeds that can be revealed and floods on from the ones whose flagged
+// and bomb counts agree, the same cells a chain of expand calls would reveal
+void expand(BitGame& game, BitGame::Bits seeds);
+
+// the expand of the move rules, does nothing for a cell off the board
+void expand(BitGame& game, int i, int j);
+
+PlayerMove try_reveal(BitGame& game, const std::pair<int, int>& place);
+
+PlayerMove try_set_flag(BitGame& game, const std::pair<int, int>& place, bool value);
+
+PlayerMove play_reveal(BitGame& game, const std::pair<int, int>& place);
+
+PlayerMove apply_move(BitGame& game, Opcode op, const std::pair<int, int>& place);
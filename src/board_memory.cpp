@@ -0,0 +1,109 @@
+#include "board_memory.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+
+namespace {
+
+size_t round_to_huge_pages(size_t bytes) {
+	return (bytes + huge_page_bytes - 1) / huge_page_bytes * huge_page_bytes;
+}
+
+void* allocate_explicit(size_t bytes) {
+#ifdef MAP_HUGETLB
+	void* data = mmap(nullptr, round_to_huge_pages(bytes), PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	return data == MAP_FAILED ? nullptr : data;
+#else
+	return nullptr;
+#endif
+}
+
+// an aligned allocation the kernel agreed to back with huge pages, or null
+void* allocate_transparent(size_t bytes) {
+#ifdef MADV_HUGEPAGE
+	size_t rounded = round_to_huge_pages(bytes);
+	void* data = std::aligned_alloc(huge_page_bytes, rounded);
+	if (data && madvise(data, rounded, MADV_HUGEPAGE) != 0) {
+		std::free(data);
+		return nullptr;
+	}
+	return data;
+#else
+	return nullptr;
+#endif
+}
+
+}
+
+unsigned fill_thread_count() {
+	static const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+	return fill_threads ? fill_threads : hardware;
+}
+
+void* board_allocate(size_t bytes, PagePolicy policy, AllocationPath& path) {
+	if (bytes >= huge_page_bytes) {
+		if (policy == PagePolicy::Explicit) {
+			if (void* data = allocate_explicit(bytes)) {
+				path = AllocationPath::Explicit;
+				return data;
+			}
+		}
+
+		if (policy != PagePolicy::Default) {
+			if (void* data = allocate_transparent(bytes)) {
+				path = AllocationPath::Transparent;
+				return data;
+			}
+		}
+	}
+
+	void* data = std::malloc(bytes);
+	if (!data) {
+		throw std::bad_alloc();
+	}
+	path = AllocationPath::Heap;
+	return data;
+}
+
+void board_free(void* data, size_t bytes, AllocationPath path) {
+	if (path == AllocationPath::Explicit) {
+		munmap(data, round_to_huge_pages(bytes));
+	} else {
+		std::free(data);
+	}
+}
+
+void for_each_band(size_t rows, size_t granule, size_t cells, const std::function<void(size_t, size_t)>& f) {
+	unsigned threads = fill_thread_count();
+	size_t granules = (rows + granule - 1) / granule;
+	if (cells < parallel_fill_cells || threads == 1 || granules < 2) {
+		if (rows) {
+			f(0, rows);
+		}
+		return;
+	}
+
+	threads = std::min<size_t>(threads, granules);
+	auto band = [&](unsigned t) {
+		size_t first = std::min(rows, granules * t / threads * granule);
+		size_t last = std::min(rows, granules * (t + 1) / threads * granule);
+		if (first < last) {
+			f(first, last);
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (unsigned t = 1; t < threads; t++) {
+		pool.emplace_back(band, t);
+	}
+	band(0);
+	for (auto& thread : pool) {
+		thread.join();
+	}
+}
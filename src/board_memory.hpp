@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <utility>
+
+// how the cells of boards of at least huge_page_bytes are backed. transparent asks the kernel to
+// back an aligned allocation with huge pages, explicit maps them from the hugetlb pool. either
+// one falls back to the next when the kernel refuses
+enum class PagePolicy : uint8_t {
+	Default = 0,
+	Transparent = 1,
+	Explicit = 2,
+};
+
+inline constexpr std::array<const char*, 3> page_policy_names{"default", "thp", "hugetlb"};
+
+// where an allocation actually ended up, named like the policies that ask for it
+enum class AllocationPath : uint8_t {
+	Heap = 0,
+	Transparent = 1,
+	Explicit = 2,
+	// carved out of the memory resource the buffer was given
+	Arena = 3,
+};
+
+inline constexpr std::array<const char*, 4> allocation_path_names{"heap", "thp", "hugetlb", "arena"};
+
+inline constexpr size_t huge_page_bytes = size_t(1) << 21;
+
+// the policy of every board allocated from now on
+inline PagePolicy board_pages = PagePolicy::Default;
+// threads that reset and generate large boards, 0 for one per hardware thread
+inline unsigned fill_threads = 0;
+// boards with fewer cells are filled on the calling thread
+inline size_t parallel_fill_cells = size_t(1) << 20;
+
+unsigned fill_thread_count();
+
+// returns at least bytes of uninitialized memory and records in path where they came from
+void* board_allocate(size_t bytes, PagePolicy policy, AllocationPath& path);
+void board_free(void* data, size_t bytes, AllocationPath path);
+
+// calls f(first, last) for bands of rows [first, last) that cover [0, rows) and start on multiples
+// of granule. a board of at least parallel_fill_cells cells is split into one band per thread, each
+// thread running f on its band alone. when f is the first to touch a band, the kernel's first-touch
+// policy places the band's pages on the node that thread ran on. the threads are not pinned and end
+// with the call, so nothing keeps later work on a band on that node
+void for_each_band(size_t rows, size_t granule, size_t cells, const std::function<void(size_t, size_t)>& f);
+
+// the storage behind a Grid: a flat array of trivially copyable elements allocated through
+// board_allocate, or from resource when there is one. allocate leaves the elements
+// uninitialized, so the caller decides which thread touches them first. a copy always goes
+// through board_allocate, like a pmr container copy goes back to the default resource
+template <typename T>
+class BoardBuffer {
+public:
+	BoardBuffer() = default;
+
+	explicit BoardBuffer(std::pmr::memory_resource* resource)
+		: resource(resource) {}
+
+	BoardBuffer(const BoardBuffer& other) {
+		allocate(other.count);
+		std::memcpy(elements, other.elements, count * sizeof(T));
+	}
+
+	BoardBuffer(BoardBuffer&& other) noexcept {
+		swap(other);
+	}
+
+	BoardBuffer& operator=(BoardBuffer other) noexcept {
+		swap(other);
+		return *this;
+	}
+
+	~BoardBuffer() {
+		release();
+	}
+
+	// makes room for count elements, keeping the allocation when it is large enough
+	void allocate(size_t count) {
+		size_t bytes = count * sizeof(T);
+		if (bytes > capacity) {
+			release();
+			if (resource) {
+				elements = static_cast<T*>(resource->allocate(bytes, alignof(T)));
+				allocation = AllocationPath::Arena;
+			} else {
+				elements = static_cast<T*>(board_allocate(bytes, board_pages, allocation));
+			}
+			capacity = bytes;
+		}
+		this->count = count;
+	}
+
+	void swap(BoardBuffer& other) noexcept {
+		std::swap(elements, other.elements);
+		std::swap(count, other.count);
+		std::swap(capacity, other.capacity);
+		std::swap(allocation, other.allocation);
+		std::swap(resource, other.resource);
+	}
+
+	T* begin() {
+		return elements;
+	}
+
+	T* end() {
+		return elements + count;
+	}
+
+	const T* begin() const {
+		return elements;
+	}
+
+	const T* end() const {
+		return elements + count;
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	T& operator[](size_t k) {
+		return elements[k];
+	}
+
+	const T& operator[](size_t k) const {
+		return elements[k];
+	}
+
+	AllocationPath path() const {
+		return allocation;
+	}
+
+	size_t bytes() const {
+		return capacity;
+	}
+
+	// the resource the elements come from, null for board_allocate
+	std::pmr::memory_resource* memory_resource() const {
+		return resource;
+	}
+
+private:
+	void release() {
+		if (elements && resource) {
+			resource->deallocate(elements, capacity, alignof(T));
+		} else if (elements) {
+			board_free(elements, capacity, allocation);
+		}
+		elements = nullptr;
+		count = 0;
+		capacity = 0;
+		allocation = AllocationPath::Heap;
+	}
+
+	T* elements = nullptr;
+	size_t count = 0;
+	size_t capacity = 0;
+	AllocationPath allocation = AllocationPath::Heap;
+	std::pmr::memory_resource* resource = nullptr;
+};
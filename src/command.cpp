@@ -0,0 +1,67 @@
+#include "command.hpp"
+
+#include <cctype>
+#include <charconv>
+
+namespace {
+
+bool is_space(char c) {
+	return std::isspace(static_cast<unsigned char>(c));
+}
+
+// calls f with every whitespace separated word of str
+template <typename F>
+void for_each_word(std::string_view str, F f) {
+	size_t k = 0;
+	while (k < str.size()) {
+		while (k < str.size() && is_space(str[k])) {
+			k++;
+		}
+
+		size_t begin = k;
+		while (k < str.size() && !is_space(str[k])) {
+			k++;
+		}
+
+		if (begin < k) {
+			f(str.substr(begin, k - begin));
+		}
+	}
+}
+
+}
+
+Command to_command(std::string_view str, std::pmr::memory_resource* resource) {
+	size_t words = 0;
+	for_each_word(str, [&words](std::string_view) { words++; });
+
+	Command result(resource);
+	result.reserve(words);
+	for_each_word(str, [&result](std::string_view word) {
+		result.emplace_back(word);
+	});
+
+	return result;
+}
+
+ParseError parse_places(const Command& command, std::pmr::vector<std::pair<int, int>>& places) {
+	if (command.size() < 3 || command.size() % 2 == 0) {
+		return ParseError::Arity;
+	}
+
+	places.clear();
+	for (size_t k = 1; k < command.size(); k += 2) {
+		int coords[2];
+		for (int c = 0; c < 2; c++) {
+			std::string_view word = command[k + c];
+			auto [end, ec] = std::from_chars(word.data(), word.data() + word.size(), coords[c]);
+			if (ec != std::errc() || end != word.data() + word.size()) {
+				return ParseError::NotANumber;
+			}
+		}
+
+		places.push_back({coords[0], coords[1]});
+	}
+
+	return ParseError::None;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+typedef std::pmr::vector<std::pmr::string> Command;
+// splits str into words; the words and the list live in resource, so a caller can parse each
+// line into a scratch arena that is dropped with the line
+Command to_command(std::string_view str, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+enum class ParseError {
+	None,
+	UnknownCommand,
+	Arity,
+	NotANumber,
+};
+
+// parses the coordinate pairs after the command word into places, which keeps its own resource
+// so that a caller can put it on the command's
+ParseError parse_places(const Command& command, std::pmr::vector<std::pair<int, int>>& places);
@@ -0,0 +1,198 @@
+#include "console.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "journal.hpp"
+#include "protocol.hpp"
+#include "render.hpp"
+#include "snapshot.hpp"
+#include "stats.hpp"
+
+void print_help() {
+	std::cout 	<< "H E L P:\n"
+			<< "(1.) Type \"flag i1 j1 i2 j2 ... in jn\" to flag the cell in the ith row (0-indexed) of the jth column (0-indexed) of the grid.\n"
+			<< "(2.) Type \"unflag i1 j1 i2 j2 ... in jn\" to unflag the cell in the ith row (0-indexed) of the jth column (0-indexed) of the grid.\n"
+			<< "(3.) Type \"reveal i1 j1 i2 j2 ... in jn\" to reveal the cell in the ith row (0-indexed) of the jth column (0-indexed) of the grid.\n"
+			<< "(4.) Type \"exit\" to exit the game.\n"
+			<< "(5.) Type \"restart\" to restart the game.\n"
+			<< "(6.) Type \"bombs_left?\" to query how many bombs haven't been flagged.\n"
+			<< "(7.) Type \"save path\" to save the game to the file at path.\n"
+			<< "(8.) Type \"load path\" to resume the game saved in the file at path, unless the game is being recorded.\n"
+			<< "(9.) Type \"undo\" to take back the last move.\n"
+			<< "(10.) Type \"redo\" to play the last move taken back again.\n"
+			<< "(11.) Type \"dump path\" to write the board as plain text to the file at path.\n"
+			<< "(12.) Type \"memory\" to show how the board's cells were allocated.\n";
+#ifdef MINES_STATS
+	std::cout << "(13.) Type \"stats\" to print the engine counters.\n";
+#endif
+}
+
+void print_parse_error(const Command& command, ParseError error) {
+	switch (error) {
+		case ParseError::UnknownCommand:
+			std::cout << "Unknown command \"" << command.front() << "\", type \"help\" for a list of commands.\n";
+			break;
+		case ParseError::Arity:
+			std::cout << "\"" << command.front() << "\" expects one or more pairs of coordinates.\n";
+			break;
+		case ParseError::NotANumber:
+			std::cout << "\"" << command.front() << "\" expects coordinates to be whole numbers.\n";
+			break;
+		default:
+			break;
+	}
+}
+
+namespace {
+
+bool flag(Game& game, const Command& command, bool value) {
+	std::pmr::vector<std::pair<int, int>> places(command.get_allocator().resource());
+	ParseError error = parse_places(command, places);
+	if (error != ParseError::None) {
+		print_parse_error(command, error);
+		return false;
+	}
+
+	for (auto [i, j] : places) {
+		switch (apply_move(game, value ? Opcode::Flag : Opcode::Unflag, {i, j})) {
+			case PlayerMove::OutBounds:
+				std::cout << "Failed (un)flagging cell: " << i << ", " << j << "], as it does not exist in grid.\n";
+				break;
+			case PlayerMove::NA:
+				std::cout << "Failed (un)flagging cell: " << i << ", " << j << "], as the cell has already been revealed.\n";
+				break;
+			default: 
+				break;
+		}
+	}
+
+	return true;
+}
+
+bool reveal(Game& game, const Command& command) {
+	std::pmr::vector<std::pair<int, int>> places(command.get_allocator().resource());
+	ParseError error = parse_places(command, places);
+	if (error != ParseError::None) {
+		print_parse_error(command, error);
+		return false;
+	}
+
+	for (auto [i, j] : places) {
+		switch (apply_move(game, Opcode::Reveal, {i, j})) {
+			case PlayerMove::NA:
+				std::cout << "Failed revealing cell: [" << i << ", " << j << "], as you cannot reveal a flagged cell.\n";
+				break;
+			case PlayerMove::OutBounds:
+				std::cout << "Failed revealing cell: [" << i << ", " << j << "], as it does not exist in the grid.\n";
+				break;
+			case PlayerMove::LosingMove:
+				return true;
+			default: 
+				break;
+		}
+	}
+
+	return true;
+}
+
+bool save(Game& game, const Command& command) {
+	if (command.size() != 2) {
+		std::cout << "\"save\" expects a single file path.\n";
+		return false;
+	}
+
+	if (!save_snapshot(game, std::string(command[1]))) {
+		std::cout << "Failed saving the game to \"" << command[1] << "\".\n";
+	}
+
+	return false;
+}
+
+bool dump(Game& game, const Command& command) {
+	if (command.size() != 2) {
+		std::cout << "\"dump\" expects a single file path.\n";
+		return false;
+	}
+
+	std::ofstream out(command[1].c_str(), std::ios::binary | std::ios::trunc);
+	render(out, game, RenderMode::Ascii);
+	if (!out) {
+		std::cout << "Failed dumping the board to \"" << command[1] << "\".\n";
+	}
+
+	return false;
+}
+
+bool load(Game& game, const Command& command) {
+	SnapshotView view;
+	if (command.size() != 2) {
+		std::cout << "\"load\" expects a single file path.\n";
+		return false;
+	}
+
+	// a replay log starts from the board its header names, it cannot restore a loaded one
+	if (game.recorder) {
+		std::cout << "\"load\" is not available while the game is being recorded.\n";
+		return false;
+	}
+
+	if (!view.open(std::string(command[1]))) {
+		std::cout << "Failed loading a game from \"" << command[1] << "\".\n";
+		return false;
+	}
+
+	Journal* journal = game.journal;
+	game = load_snapshot(view, game.grid.cell_layout());
+	game.journal = journal;
+	if (journal) {
+		journal->clear();
+	}
+	return true;
+}
+
+bool print_undo_result(PlayerMove result, const char* what) {
+	if (result != PlayerMove::Success) {
+		std::cout << "There is nothing to " << what << ".\n";
+		return false;
+	}
+
+	return true;
+}
+
+void print_bombs_left(Game& game) {
+	std::cout << "There are " << game.bombs_left() << " bombs left.\n";
+}
+
+void print_memory(const Game& game) {
+	auto& cells = game.grid.storage();
+	std::cout << "The board's " << cells.size() << " cells take " << cells.bytes() << " bytes, allocated from "
+		<< allocation_path_names[static_cast<size_t>(cells.path())] << " pages.\n";
+}
+
+}
+
+#define Option [](Game& game, const Command& command)
+
+const std::map<std::string, CommandHandler, std::less<>> command_table{
+	{"flag", Option { return flag(game, command, true); }},
+	{"unflag", Option { return flag(game, command, false); }},
+	{"reveal", reveal},
+	{"help", Option { print_help(); return true; }},
+	{"exit", Option { game.state = GameState::OVER; return false; }},
+	{"restart", Option { apply_move(game, Opcode::Restart, {0, 0}); return true; }},
+	{"bombs_left?", Option { print_bombs_left(game); return true; }},
+	{"memory", Option { print_memory(game); return true; }},
+	{"save", save},
+	{"load", load},
+	{"dump", dump},
+	{"undo", Option { return print_undo_result(apply_move(game, Opcode::Undo, {0, 0}), "undo"); }},
+	{"redo", Option { return print_undo_result(apply_move(game, Opcode::Redo, {0, 0}), "redo"); }},
+#ifdef MINES_STATS
+	{"stats", Option { stats::report(std::cout); return false; }},
+#endif
+};
+
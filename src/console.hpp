@@ -0,0 +1,19 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+
+#include "command.hpp"
+#include "game.hpp"
+
+void print_help();
+
+void print_parse_error(const Command& command, ParseError error);
+
+// runs one typed command on the game and returns whether the board should be drawn again
+using CommandHandler = std::function<bool(Game& game, const Command& command)>;
+
+// the commands of the interactive game by their first word. transparent, so that commands are
+// looked up without copying their first word
+extern const std::map<std::string, CommandHandler, std::less<>> command_table;
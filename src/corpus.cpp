@@ -0,0 +1,64 @@
+#include "corpus.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "metrics.hpp"
+
+bool build_corpus(const std::string& path, size_t m, size_t n, float bomb_likelihood, uint64_t base_seed, uint64_t count, bool annotate) {
+	CorpusHeader header{};
+	std::memcpy(header.magic, corpus_magic, sizeof(header.magic));
+	header.rows = m;
+	header.cols = n;
+	header.bomb_likelihood = bomb_likelihood;
+	header.count = count;
+	header.words_per_board = (m * n + 63) / 64;
+	header.annotated = annotate;
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	std::vector<uint64_t> record(corpus_record_size(header) / sizeof(uint64_t));
+	for (uint64_t k = 0; k < count && out; k++) {
+		std::fill(record.begin(), record.end(), 0);
+		CorpusBoard board{};
+		board.seed = base_seed + k;
+
+		uint64_t* bombs = record.data() + sizeof(CorpusBoard) / sizeof(uint64_t);
+		for (size_t c = 0; c < m * n; c++) {
+			if (is_bomb_at(board.seed, c, bomb_likelihood)) {
+				bombs[c / 64] |= 1ull << (c % 64);
+				board.count_bombs++;
+			}
+		}
+
+		if (annotate) {
+			BoardMetrics metrics = compute_metrics(m, n, [bombs, n](size_t i, size_t j) {
+				return test_bit(bombs, i * n + j);
+			});
+			board.bbbv = metrics.bbbv;
+			board.openings = metrics.openings;
+			board.isolated = metrics.isolated;
+		}
+
+		std::memcpy(record.data(), &board, sizeof(board));
+		out.write(reinterpret_cast<const char*>(record.data()), record.size() * sizeof(uint64_t));
+	}
+
+	return static_cast<bool>(out);
+}
+
+Game load_corpus_board(const CorpusView& view, uint64_t k, Layout layout) {
+	const CorpusHeader& header = *view.header;
+	const uint64_t* bombs = view.bombs(k);
+	Game game(0, 0, header.bomb_likelihood, view.board(k).seed);
+	game.grid.assign(header.rows, header.cols, layout);
+	for (size_t i = 0; i < header.rows; i++) {
+		for (size_t j = 0; j < header.cols; j++) {
+			game.set_bomb(i, j, test_bit(bombs, i * header.cols + j));
+		}
+	}
+
+	return game;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "game.hpp"
+#include "mapped_file.hpp"
+#include "snapshot.hpp"
+
+// corpus: a header followed by count fixed-size records, so board k lives at a computed
+// offset. a record is a CorpusBoard followed by the words_per_board words of its bomb plane.
+constexpr char corpus_magic[4] = {'M', 'N', 'C', 'P'};
+
+struct CorpusHeader {
+	char magic[4];
+	uint32_t rows;
+	uint32_t cols;
+	float bomb_likelihood;
+	uint64_t count;
+	uint64_t words_per_board;
+	uint32_t annotated;
+	uint32_t reserved;
+};
+
+// the metrics are only filled in when the corpus is annotated
+struct CorpusBoard {
+	uint64_t seed;
+	uint32_t count_bombs;
+	uint32_t bbbv;
+	uint32_t openings;
+	uint32_t isolated;
+};
+
+static_assert(sizeof(CorpusHeader) % sizeof(uint64_t) == 0, "records must stay word aligned");
+
+inline size_t corpus_record_size(const CorpusHeader& header) {
+	return sizeof(CorpusBoard) + header.words_per_board * sizeof(uint64_t);
+}
+
+bool build_corpus(const std::string& path, size_t m, size_t n, float bomb_likelihood, uint64_t base_seed, uint64_t count, bool annotate);
+
+struct CorpusView {
+	MappedFile file;
+	const CorpusHeader* header = nullptr;
+
+	bool open(const std::string& path) {
+		if (!file.open(path, sizeof(CorpusHeader))) {
+			return false;
+		}
+
+		header = static_cast<const CorpusHeader*>(file.data);
+		if (std::memcmp(header->magic, corpus_magic, sizeof(corpus_magic)) != 0
+			|| !header->rows || !header->cols || static_cast<uint64_t>(header->rows) * header->cols > Game::max_cells
+			|| header->words_per_board != (static_cast<uint64_t>(header->rows) * header->cols + 63) / 64) {
+			return false;
+		}
+
+		// divided rather than multiplied, a count near the top of its range would wrap the product
+		return header->count <= (file.size - sizeof(CorpusHeader)) / corpus_record_size(*header);
+	}
+
+	const CorpusBoard& board(uint64_t k) const {
+		auto base = static_cast<const char*>(file.data) + sizeof(CorpusHeader);
+		return *reinterpret_cast<const CorpusBoard*>(base + k * corpus_record_size(*header));
+	}
+
+	const uint64_t* bombs(uint64_t k) const {
+		return reinterpret_cast<const uint64_t*>(&board(k) + 1);
+	}
+};
+
+Game load_corpus_board(const CorpusView& view, uint64_t k, Layout layout = Layout::RowMajor);
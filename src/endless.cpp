@@ -0,0 +1,191 @@
+#include "endless.hpp"
+
+#include "rules.hpp"
+
+namespace {
+
+constexpr int cell_mask = EndlessGame::chunk_size - 1;
+
+bool test(const EndlessGame::Plane& plane, int i, int j) {
+	return plane[i & cell_mask] >> (j & cell_mask) & 1;
+}
+
+void assign(EndlessGame::Plane& plane, int i, int j, bool value) {
+	uint64_t bit = uint64_t(1) << (j & cell_mask);
+	plane[i & cell_mask] = value ? plane[i & cell_mask] | bit : plane[i & cell_mask] & ~bit;
+}
+
+// the cells set in the 3 x 3 window around (r, c) of a plane, the centre included. (r, c) must
+// not be on the border of the chunk
+uint32_t window_count(const EndlessGame::Plane& plane, int r, int c) {
+	uint64_t mask = uint64_t(7) << (c - 1);
+	return __builtin_popcountll(plane[r - 1] & mask) + __builtin_popcountll(plane[r] & mask)
+		+ __builtin_popcountll(plane[r + 1] & mask);
+}
+
+bool on_chunk_border(int i, int j) {
+	int r = i & cell_mask;
+	int c = j & cell_mask;
+	return r == 0 || c == 0 || r == cell_mask || c == cell_mask;
+}
+
+}
+
+EndlessGame::EndlessGame(float bomb_likelihood, uint64_t seed)
+	: seed(seed), bomb_likelihood(bomb_likelihood) {}
+
+void EndlessGame::new_board(uint64_t board_seed) {
+	seed = board_seed;
+	restart();
+}
+
+void EndlessGame::restart() {
+	first_move = true;
+	state = GameState::ACTIVE;
+	count_flagged = 0;
+	count_revealed = 0;
+	last_revealed.clear();
+	chunks.clear();
+	cached = nullptr;
+}
+
+const EndlessGame::Chunk* EndlessGame::find_chunk(int i, int j) const {
+	uint64_t key = chunk_key(i, j);
+	if (cached && cached_key == key) {
+		return cached;
+	}
+
+	auto found = chunks.find(key);
+	if (found == chunks.end()) {
+		return nullptr;
+	}
+
+	cached_key = key;
+	cached = &found->second;
+	return cached;
+}
+
+EndlessGame::Chunk& EndlessGame::touch_chunk(int i, int j) {
+	if (const Chunk* chunk = find_chunk(i, j)) {
+		return const_cast<Chunk&>(*chunk);
+	}
+
+	MINES_COUNT(ChunksMaterialized, 1);
+	Chunk& chunk = chunks[chunk_key(i, j)];
+	int top = i & ~cell_mask;
+	int left = j & ~cell_mask;
+	for (int r = 0; r < chunk_size; r++) {
+		uint64_t row = 0;
+		for (int c = 0; c < chunk_size; c++) {
+			row |= uint64_t(is_endless_bomb_at(seed, top + r, left + c, bomb_likelihood)) << c;
+		}
+		chunk.bombs[r] = row;
+	}
+
+	cached_key = chunk_key(i, j);
+	cached = &chunk;
+	return chunk;
+}
+
+bool EndlessGame::is_bomb(int i, int j) const {
+	const Chunk* chunk = find_chunk(i, j);
+	return chunk ? test(chunk->bombs, i, j) : is_endless_bomb_at(seed, i, j, bomb_likelihood);
+}
+
+bool EndlessGame::is_flagged(int i, int j) const {
+	const Chunk* chunk = find_chunk(i, j);
+	return chunk && test(chunk->flags, i, j);
+}
+
+bool EndlessGame::is_revealed(int i, int j) const {
+	const Chunk* chunk = find_chunk(i, j);
+	return chunk && test(chunk->revealed, i, j);
+}
+
+void EndlessGame::set_bomb(int i, int j, bool value) {
+	Chunk& chunk = touch_chunk(i, j);
+	bool bomb = test(chunk.bombs, i, j);
+	if (bomb == value) {
+		return;
+	}
+
+	assign(chunk.bombs, i, j, value);
+	if (test(chunk.revealed, i, j)) {
+		count_revealed += value ? -1 : 1;
+	}
+}
+
+void EndlessGame::set_flagged(int i, int j, bool value) {
+	Chunk& chunk = touch_chunk(i, j);
+	if (test(chunk.flags, i, j) == value) {
+		return;
+	}
+
+	assign(chunk.flags, i, j, value);
+	count_flagged += value ? 1 : -1;
+}
+
+bool EndlessGame::set_revealed(int i, int j) {
+	Chunk& chunk = touch_chunk(i, j);
+	if (test(chunk.revealed, i, j)) {
+		return false;
+	}
+
+	assign(chunk.revealed, i, j, true);
+	count_revealed += !test(chunk.bombs, i, j);
+	return true;
+}
+
+uint32_t count_bomb_neighbors(const EndlessGame& game, int i, int j) {
+	MINES_COUNT(NeighborScans, 1);
+	const EndlessGame::Chunk* chunk = game.find_chunk(i, j);
+	if (chunk && !on_chunk_border(i, j)) {
+		int r = i & cell_mask;
+		int c = j & cell_mask;
+		return window_count(chunk->bombs, r, c) - test(chunk->bombs, i, j);
+	}
+
+	uint32_t result = 0;
+	for_each_neighbor<dir8>(i, j, [&](int a, int b) {
+		result += game.is_bomb(a, b);
+	});
+
+	return result;
+}
+
+uint32_t count_flagged_neighbors(const EndlessGame& game, int i, int j) {
+	MINES_COUNT(NeighborScans, 1);
+	const EndlessGame::Chunk* chunk = game.find_chunk(i, j);
+	if (chunk && !on_chunk_border(i, j)) {
+		int r = i & cell_mask;
+		int c = j & cell_mask;
+		return window_count(chunk->flags, r, c) - test(chunk->flags, i, j);
+	}
+
+	uint32_t result = 0;
+	for_each_neighbor<dir8>(i, j, [&](int a, int b) {
+		result += game.is_flagged(a, b);
+	});
+
+	return result;
+}
+
+void expand(EndlessGame& game, int i, int j) {
+	rules::cascade(game, i, j);
+}
+
+PlayerMove try_reveal(EndlessGame& game, const std::pair<int, int>& place) {
+	return rules::try_reveal(game, place);
+}
+
+PlayerMove try_set_flag(EndlessGame& game, const std::pair<int, int>& place, bool value) {
+	return rules::try_set_flag(game, place, value);
+}
+
+PlayerMove play_reveal(EndlessGame& game, const std::pair<int, int>& place) {
+	return rules::play_reveal(game, place);
+}
+
+PlayerMove apply_move(EndlessGame& game, Opcode op, const std::pair<int, int>& place) {
+	return rules::apply_move(game, op, place);
+}
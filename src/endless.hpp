@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "game.hpp"
+#include "protocol.hpp"
+
+// a board without edges, short of the int limits. a bomb is a pure function of the seed and the cell, so no part of the
+// board has to exist before it is looked at: the cells live in 64 x 64 chunks that are only
+// materialized when one of their cells is written, and memory grows with the explored area.
+// the moves are the rules of rules.hpp on a rectangle, except that the board cannot be won and a
+// cascade stops spreading after cascade_limit cells. the cells it had yet to spread from stay
+// revealed, so chording one of them carries on where it stopped.
+struct EndlessGame {
+	static constexpr int chunk_bits = 6;
+	static constexpr int chunk_size = 1 << chunk_bits;
+
+	// one bit per cell, row r of the chunk in word r and column c in bit c
+	using Plane = std::array<uint64_t, chunk_size>;
+
+	struct Chunk {
+		Plane bombs;
+		Plane flags{};
+		Plane revealed{};
+	};
+
+	uint64_t seed;
+	float bomb_likelihood;
+	bool first_move = true;
+	GameState state = GameState::ACTIVE;
+	uint64_t count_flagged = 0;
+	// revealed cells that are not bombs, the score of the game
+	uint64_t count_revealed = 0;
+	size_t cascade_limit = 1 << 16;
+	// the cells revealed by the last try_reveal
+	std::vector<std::pair<int, int>> last_revealed;
+	// keyed by chunk_key; nodes are stable, so a chunk never moves once materialized
+	std::unordered_map<uint64_t, Chunk> chunks;
+
+	EndlessGame(float bomb_likelihood, uint64_t seed);
+	// the lookup cache points into chunks, so a game is moved but never copied
+	EndlessGame(const EndlessGame&) = delete;
+	EndlessGame& operator=(const EndlessGame&) = delete;
+	EndlessGame(EndlessGame&&) = default;
+	EndlessGame& operator=(EndlessGame&&) = default;
+
+	void new_board(uint64_t board_seed);
+	// drops every chunk, the board is drawn again from the seed as it is explored
+	void restart();
+
+	static uint64_t chunk_key(int i, int j) {
+		return uint64_t(uint32_t(i >> chunk_bits)) << 32 | uint32_t(j >> chunk_bits);
+	}
+
+	// the chunk holding (i, j), or null while none of its cells was written
+	const Chunk* find_chunk(int i, int j) const;
+	// the chunk holding (i, j), drawing its bombs from the seed when it does not exist yet
+	Chunk& touch_chunk(int i, int j);
+
+	// the board stops one cell short of the int limits, so that every neighbour of a cell on it is
+	// an int too. wider arguments let a caller check a window before it is moved there
+	static constexpr bool outside(int64_t i, int64_t j) {
+		return i <= std::numeric_limits<int>::min() || j <= std::numeric_limits<int>::min()
+			|| i >= std::numeric_limits<int>::max() || j >= std::numeric_limits<int>::max();
+	}
+
+	bool is_bomb(int i, int j) const;
+	bool is_flagged(int i, int j) const;
+	bool is_revealed(int i, int j) const;
+
+	void set_bomb(int i, int j, bool value);
+	void set_flagged(int i, int j, bool value);
+	// returns whether the cell was hidden
+	bool set_revealed(int i, int j);
+
+	void clear_last_revealed() {
+		last_revealed.clear();
+	}
+
+	void add_last_revealed(int i, int j) {
+		last_revealed.push_back({i, j});
+	}
+
+	size_t count_last_revealed() const {
+		return last_revealed.size();
+	}
+
+	static std::vector<std::pair<int, int>> cascade_stack() {
+		return {};
+	}
+
+	// a sparse enough board opens without end, so the cascade is cut off after cascade_limit cells
+	bool cut_cascade(const std::vector<std::pair<int, int>>&, size_t revealed) const {
+		return revealed >= cascade_limit;
+	}
+
+	size_t count_chunks() const {
+		return chunks.size();
+	}
+
+private:
+	// the last chunk found, cascades stay within one chunk for long stretches
+	mutable uint64_t cached_key = 0;
+	mutable const Chunk* cached = nullptr;
+};
+
+// whether (i, j) holds a bomb on the endless board drawn from seed
+inline bool is_endless_bomb_at(uint64_t seed, int i, int j, float bomb_likelihood) {
+	return is_bomb_at(seed, uint64_t(uint32_t(i)) << 32 | uint32_t(j), bomb_likelihood);
+}
+
+// an endless board is never won
+inline bool is_won(const EndlessGame&) {
+	return false;
+}
+
+uint32_t count_bomb_neighbors(const EndlessGame& game, int i, int j);
+
+uint32_t count_flagged_neighbors(const EndlessGame& game, int i, int j);
+
+template <typename F>
+void for_each_adjacent(const EndlessGame&, int i, int j, F f) {
+	for_each_neighbor<dir8>(i, j, f);
+}
+
+template <typename F>
+void for_each_spread(const EndlessGame& game, int i, int j, F f) {
+	for_each_neighbor<dir4>(i, j, [&](int a, int b) {
+		if (!game.outside(a, b)) {
+			f(a, b);
+		}
+	});
+}
+
+void expand(EndlessGame& game, int i, int j);
+
+PlayerMove try_reveal(EndlessGame& game, const std::pair<int, int>& place);
+
+PlayerMove try_set_flag(EndlessGame& game, const std::pair<int, int>& place, bool value);
+
+PlayerMove play_reveal(EndlessGame& game, const std::pair<int, int>& place);
+
+PlayerMove apply_move(EndlessGame& game, Opcode op, const std::pair<int, int>& place);
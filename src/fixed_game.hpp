@@ -0,0 +1,272 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "game.hpp"
+#include "protocol.hpp"
+#include "rules.hpp"
+
+// the cascade stack of a FixedGame: cells as 16-bit indices rather than pairs. a cell is pushed
+// only by the visit that revealed it, so the stack never outgrows the board
+template <size_t R, size_t C>
+struct CellStack {
+	std::array<uint16_t, R * C> cells;
+	size_t count = 0;
+
+	void push_back(const std::pair<int, int>& cell) {
+		cells[count++] = cell.first * C + cell.second;
+	}
+
+	std::pair<int, int> back() const {
+		return {cells[count - 1] / C, cells[count - 1] % C};
+	}
+
+	void pop_back() {
+		count--;
+	}
+
+	bool empty() const {
+		return !count;
+	}
+
+	size_t size() const {
+		return count;
+	}
+};
+
+// a game whose size is fixed at compile time, for the standard sizes that the simulator and
+// server paths create and discard in bulk. the cells live inline, so a game never touches the
+// heap, and every bounds check folds against R and C. the moves are the rules of rules.hpp,
+// and the same seed draws the same board.
+template <size_t R, size_t C, typename Topo = Rectangle>
+struct FixedGame {
+	static constexpr size_t rows = R;
+	static constexpr size_t cols = C;
+	static constexpr size_t cells = R * C;
+	static_assert(cells <= UINT16_MAX, "cell indices are kept in 16 bits");
+	static_assert(fits(Topo::kind, R, C), "a torus needs at least 3 rows and columns");
+
+	struct Cell {
+		bool bomb = false;
+		bool flagged = false;
+		bool revealed = false;
+	};
+
+	uint64_t seed;
+	float bomb_likelihood;
+	uint32_t count_bombs = 0;
+	uint32_t count_flagged = 0;
+	uint32_t count_correct_flags = 0;
+	uint32_t count_revealed = 0;
+	bool first_move = true;
+	GameState state = GameState::ACTIVE;
+	std::array<Cell, cells> grid{};
+	// row-major indices of the cells revealed by the last try_reveal
+	std::array<uint16_t, cells> last_revealed;
+	size_t last_revealed_size = 0;
+
+	FixedGame(float bomb_likelihood, uint64_t seed)
+		: seed(seed), bomb_likelihood(bomb_likelihood)
+	{
+		fill_grid();
+	}
+
+	void fill_grid() {
+		grid.fill(Cell{});
+		count_bombs = 0;
+		count_flagged = 0;
+		count_correct_flags = 0;
+		count_revealed = 0;
+		last_revealed_size = 0;
+
+		for (size_t k = 0; k < cells; k++) {
+			set_bomb(k / C, k % C, is_bomb_at(seed, k, bomb_likelihood));
+		}
+	}
+
+	void new_board(uint64_t board_seed) {
+		seed = board_seed;
+		first_move = true;
+		state = GameState::ACTIVE;
+		fill_grid();
+	}
+
+	static constexpr bool outside(int i, int j) {
+		return !inside(R, C, i, j);
+	}
+
+	Cell& at(size_t i, size_t j) {
+		return grid[i * C + j];
+	}
+
+	const Cell& at(size_t i, size_t j) const {
+		return grid[i * C + j];
+	}
+
+	bool is_bomb(size_t i, size_t j) const {
+		return at(i, j).bomb;
+	}
+
+	bool is_flagged(size_t i, size_t j) const {
+		return at(i, j).flagged;
+	}
+
+	bool is_revealed(size_t i, size_t j) const {
+		return at(i, j).revealed;
+	}
+
+	void clear_last_revealed() {
+		last_revealed_size = 0;
+	}
+
+	void add_last_revealed(size_t i, size_t j) {
+		last_revealed[last_revealed_size++] = i * C + j;
+	}
+
+	size_t count_last_revealed() const {
+		return last_revealed_size;
+	}
+
+	// the cells are left uninitialized, only those below count are ever read
+	static CellStack<R, C> cascade_stack() {
+		CellStack<R, C> stack;
+		return stack;
+	}
+
+	// nothing to hand a cascade over to, it always runs to the end
+	static constexpr bool cut_cascade(const CellStack<R, C>&, size_t) {
+		return false;
+	}
+
+	static constexpr size_t count_cells() {
+		return cells;
+	}
+
+	size_t safe_cells_left() const {
+		return cells - count_bombs - count_revealed;
+	}
+
+	uint32_t bombs_left() const {
+		return count_flagged >= count_bombs ? 0 : count_bombs - count_flagged;
+	}
+
+	void set_bomb(size_t i, size_t j, bool value) {
+		Cell& cell = at(i, j);
+		if (cell.bomb == value) {
+			return;
+		}
+
+		int delta = value ? 1 : -1;
+		cell.bomb = value;
+		count_bombs += delta;
+		count_correct_flags += cell.flagged ? delta : 0;
+		count_revealed -= cell.revealed ? delta : 0;
+	}
+
+	void set_flagged(size_t i, size_t j, bool value) {
+		Cell& cell = at(i, j);
+		if (cell.flagged == value) {
+			return;
+		}
+
+		int delta = value ? 1 : -1;
+		cell.flagged = value;
+		count_flagged += delta;
+		count_correct_flags += cell.bomb ? delta : 0;
+	}
+
+	// returns whether the cell was hidden
+	bool set_revealed(size_t i, size_t j) {
+		Cell& cell = at(i, j);
+		if (cell.revealed) {
+			return false;
+		}
+
+		cell.revealed = true;
+		count_revealed += !cell.bomb;
+		return true;
+	}
+
+	void restart() {
+		first_move = true;
+		state = GameState::ACTIVE;
+		count_flagged = 0;
+		count_correct_flags = 0;
+		count_revealed = 0;
+		last_revealed_size = 0;
+
+		for (auto& cell : grid) {
+			cell.flagged = false;
+			cell.revealed = false;
+		}
+	}
+};
+
+using BeginnerGame = FixedGame<9, 9>;
+using IntermediateGame = FixedGame<16, 16>;
+using ExpertGame = FixedGame<16, 30>;
+
+template <size_t R, size_t C, typename Topo>
+bool is_won(const FixedGame<R, C, Topo>& game) {
+	return game.safe_cells_left() == 0;
+}
+
+template <size_t R, size_t C, typename Topo, typename Predicate>
+uint32_t count_neighbors(const FixedGame<R, C, Topo>& game, int i, int j, Predicate predicate) {
+	uint32_t result = 0;
+	Topo::for_each_adjacent(R, C, i, j, [&](int a, int b) {
+		result += predicate(game.at(a, b));
+	});
+
+	return result;
+}
+
+template <size_t R, size_t C, typename Topo>
+uint32_t count_bomb_neighbors(const FixedGame<R, C, Topo>& game, int i, int j) {
+	MINES_COUNT(NeighborScans, 1);
+	return count_neighbors(game, i, j, [](auto& cell) { return cell.bomb; });
+}
+
+template <size_t R, size_t C, typename Topo>
+uint32_t count_flagged_neighbors(const FixedGame<R, C, Topo>& game, int i, int j) {
+	MINES_COUNT(NeighborScans, 1);
+	return count_neighbors(game, i, j, [](auto& cell) { return cell.flagged; });
+}
+
+template <size_t R, size_t C, typename Topo, typename F>
+void for_each_spread(const FixedGame<R, C, Topo>&, int i, int j, F f) {
+	Topo::for_each_spread(R, C, i, j, f);
+}
+
+template <size_t R, size_t C, typename Topo>
+void expand(FixedGame<R, C, Topo>& game, int i, int j) {
+	rules::cascade(game, i, j);
+}
+
+template <size_t R, size_t C, typename Topo, typename F>
+void for_each_adjacent(const FixedGame<R, C, Topo>&, int i, int j, F f) {
+	Topo::for_each_adjacent(R, C, i, j, f);
+}
+
+template <size_t R, size_t C, typename Topo>
+PlayerMove try_reveal(FixedGame<R, C, Topo>& game, const std::pair<int, int>& place) {
+	return rules::try_reveal(game, place);
+}
+
+template <size_t R, size_t C, typename Topo>
+PlayerMove try_set_flag(FixedGame<R, C, Topo>& game, const std::pair<int, int>& place, bool value) {
+	return rules::try_set_flag(game, place, value);
+}
+
+template <size_t R, size_t C, typename Topo>
+PlayerMove play_reveal(FixedGame<R, C, Topo>& game, const std::pair<int, int>& place) {
+	return rules::play_reveal(game, place);
+}
+
+template <size_t R, size_t C, typename Topo>
+PlayerMove apply_move(FixedGame<R, C, Topo>& game, Opcode op, const std::pair<int, int>& place) {
+	return rules::apply_move(game, op, place);
+}
@@ -0,0 +1,136 @@
+#include "flood.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+class Barrier {
+public:
+	explicit Barrier(unsigned count)
+		: count(count) {}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		unsigned generation = this->generation;
+		if (++waiting == count) {
+			waiting = 0;
+			this->generation++;
+			released.notify_all();
+			return;
+		}
+
+		released.wait(lock, [&] { return this->generation != generation; });
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable released;
+	unsigned count;
+	unsigned waiting = 0;
+	unsigned generation = 0;
+};
+
+// frontier cells are handed out to the threads in chunks of this many
+constexpr size_t chunk = 256;
+
+}
+
+unsigned flood_thread_count() {
+	static const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+	return flood_threads ? flood_threads : hardware;
+}
+
+template <typename Topo>
+void parallel_flood(Game& game, const std::pmr::vector<std::pair<int, int>>& start, unsigned threads) {
+	int m = game.grid.rows();
+	int n = game.grid.cols();
+
+	// while the bfs runs the grid is only read: a cell belongs to the thread that sets its bit
+	// here first, and each thread reveals its own cells once the last level is done
+	std::vector<std::atomic<uint64_t>> claimed((static_cast<size_t>(m) * n + 63) / 64);
+	std::vector<uint32_t> frontier;
+	for (auto [i, j] : start) {
+		frontier.push_back(i * n + j);
+	}
+
+	std::vector<std::vector<uint32_t>> visited(threads);
+	std::vector<std::vector<uint32_t>> next(threads);
+	std::atomic<size_t> cursor{0};
+	bool done = false;
+	Barrier barrier(threads);
+
+	auto worker = [&](unsigned t) {
+		while (true) {
+			for (size_t begin; (begin = cursor.fetch_add(chunk, std::memory_order_relaxed)) < frontier.size();) {
+				size_t end = std::min(begin + chunk, frontier.size());
+				for (size_t k = begin; k < end; k++) {
+					Topo::for_each_spread(m, n, frontier[k] / n, frontier[k] % n, [&](int a, int b) {
+						MINES_COUNT(ExpandVisits, 1);
+						const Cell& cell = game.grid.at(a, b);
+						if (cell.type == CellType::BOMB || cell.is_revealed(game.epoch) || cell.is_flagged(game.epoch)) {
+							return;
+						}
+
+						uint32_t index = a * n + b;
+						uint64_t bit = uint64_t(1) << (index % 64);
+						if (claimed[index / 64].fetch_or(bit, std::memory_order_relaxed) & bit) {
+							return;
+						}
+
+						visited[t].push_back(index);
+						if (count_flagged_neighbors<Topo>(game.grid, a, b, game.epoch) == count_bomb_neighbors<Topo>(game.grid, a, b)) {
+							next[t].push_back(index);
+						}
+					});
+				}
+			}
+
+			barrier.wait();
+			if (t == 0) {
+				frontier.clear();
+				for (auto& cells : next) {
+					frontier.insert(frontier.end(), cells.begin(), cells.end());
+					cells.clear();
+				}
+				cursor.store(0, std::memory_order_relaxed);
+				done = frontier.empty();
+			}
+			barrier.wait();
+
+			if (done) {
+				break;
+			}
+		}
+
+		for (uint32_t index : visited[t]) {
+			Cell& cell = game.grid.at(index / n, index % n);
+			cell.refresh(game.epoch);
+			cell.revealed = true;
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (unsigned t = 1; t < threads; t++) {
+		pool.emplace_back(worker, t);
+	}
+	worker(0);
+	for (auto& thread : pool) {
+		thread.join();
+	}
+
+	// the claimed cells are all safe and were all hidden, so each one adds to count_revealed
+	for (auto& cells : visited) {
+		game.count_revealed += cells.size();
+		game.last_revealed.insert(game.last_revealed.end(), cells.begin(), cells.end());
+		MINES_COUNT(RevealedCells, cells.size());
+	}
+}
+
+template void parallel_flood<Rectangle>(Game&, const std::pmr::vector<std::pair<int, int>>&, unsigned);
+template void parallel_flood<Torus>(Game&, const std::pmr::vector<std::pair<int, int>>&, unsigned);
+template void parallel_flood<Hex>(Game&, const std::pmr::vector<std::pair<int, int>>&, unsigned);
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "game.hpp"
+
+// a cascade hands over to the parallel flood once this many cells are pending on its stack
+inline size_t flood_handoff = 1 << 14;
+// threads of the parallel flood, 0 for one per hardware thread; 1 keeps every cascade serial
+inline unsigned flood_threads = 0;
+
+unsigned flood_thread_count();
+
+// level-synchronous parallel bfs from frontier, revealed cells that the cascade continues
+// through. reveals exactly the cells the serial expand would and appends them to last_revealed.
+// the workers allocate concurrently, so their lists stay on the global allocator even when the
+// game is on an arena
+template <typename Topo>
+void parallel_flood(Game& game, const std::pmr::vector<std::pair<int, int>>& frontier, unsigned threads);
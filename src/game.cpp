@@ -0,0 +1,120 @@
+#include "game.hpp"
+
+#include <cassert>
+
+#include "flood.hpp"
+#include "render.hpp"
+#include "rules.hpp"
+
+namespace {
+
+// the game under one topology, so that the cascade resolves its neighbourhood once per expand
+// rather than once per cell
+template <typename Topo>
+struct TopologyView {
+	Game& game;
+	unsigned threads;
+
+	bool outside(int i, int j) const {
+		return game.outside(i, j);
+	}
+
+	bool is_bomb(int i, int j) const {
+		return game.is_bomb(i, j);
+	}
+
+	bool is_flagged(int i, int j) const {
+		return game.is_flagged(i, j);
+	}
+
+	bool is_revealed(int i, int j) const {
+		return game.is_revealed(i, j);
+	}
+
+	void set_revealed(int i, int j) {
+		game.set_revealed(i, j);
+	}
+
+	void add_last_revealed(int i, int j) {
+		game.add_last_revealed(i, j);
+	}
+
+	size_t count_last_revealed() const {
+		return game.last_revealed.size();
+	}
+
+	std::pmr::vector<std::pair<int, int>> cascade_stack() const {
+		return std::pmr::vector<std::pair<int, int>>(game.grid.memory_resource());
+	}
+
+	// a cascade that keeps growing is finished by the parallel flood
+	bool cut_cascade(const std::pmr::vector<std::pair<int, int>>& pending, size_t) {
+		if (threads > 1 && pending.size() >= flood_handoff) {
+			parallel_flood<Topo>(game, pending, threads);
+			return true;
+		}
+
+		return false;
+	}
+};
+
+template <typename Topo>
+uint32_t count_bomb_neighbors(const TopologyView<Topo>& view, int i, int j) {
+	return count_bomb_neighbors<Topo>(view.game.grid, i, j);
+}
+
+template <typename Topo>
+uint32_t count_flagged_neighbors(const TopologyView<Topo>& view, int i, int j) {
+	return count_flagged_neighbors<Topo>(view.game.grid, i, j, view.game.epoch);
+}
+
+template <typename Topo, typename F>
+void for_each_spread(const TopologyView<Topo>& view, int i, int j, F f) {
+	Topo::for_each_spread(view.game.grid.rows(), view.game.grid.cols(), i, j, f);
+}
+
+}
+
+std::ostream& operator<<(std::ostream& os, const Game& game) {
+	render(os, game, RenderMode::Ansi);
+	return os;
+}
+
+void expand(Game& game, int i, int j) {
+	if (outside(game.grid, i, j)) {
+		return;
+	}
+
+	assert(fits(game.topology, game.grid.rows(), game.grid.cols()));
+	with_topology(game.topology, [&](auto topo) {
+		TopologyView<decltype(topo)> view{game, flood_thread_count()};
+		rules::cascade(view, i, j);
+	});
+}
+
+PlayerMove try_reveal(Game& game, const std::pair<int, int>& place) {
+	MINES_TRACE_SCOPE(Reveal);
+	return rules::try_reveal(game, place);
+}
+
+PlayerMove try_set_flag(Game& game, const std::pair<int, int>& place, bool value) {
+	return rules::try_set_flag(game, place, value);
+}
+
+PlayerMove play_reveal(Game& game, const std::pair<int, int>& place) {
+	return rules::play_reveal(game, place);
+}
+
+bool counters_consistent(const Game& game) {
+	uint32_t bombs = 0, flagged = 0, correct_flags = 0, revealed = 0;
+	for (auto& cell : game.grid.storage()) {
+		bool bomb = cell.type == CellType::BOMB;
+		bombs += bomb;
+		flagged += cell.is_flagged(game.epoch);
+		correct_flags += cell.is_flagged(game.epoch) && bomb;
+		revealed += cell.is_revealed(game.epoch) && !bomb;
+	}
+
+	return bombs == game.count_bombs && flagged == game.count_flagged
+		&& correct_flags == game.count_correct_flags && revealed == game.count_revealed;
+}
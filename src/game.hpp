@@ -0,0 +1,458 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "board_memory.hpp"
+#include "stats.hpp"
+#include "topology.hpp"
+#include "trace.hpp"
+
+enum class CellType {
+	EMPTY,
+	BOMB,
+};
+
+struct Cell {
+	CellType type;
+	// the restart generation the flag and reveal bits were written in; they read as
+	// false once the game has moved on to a later epoch, see Game::restart
+	uint16_t epoch;
+	bool flagged;
+	bool revealed;
+
+	Cell(CellType type) 
+		: type(type), epoch(0), flagged(false), revealed(false) {}
+
+	bool is_flagged(uint16_t current) const {
+		return flagged && epoch == current;
+	}
+
+	bool is_revealed(uint16_t current) const {
+		return revealed && epoch == current;
+	}
+
+	// drops the bits of an earlier epoch before the cell is written to
+	void refresh(uint16_t current) {
+		if (epoch != current) {
+			epoch = current;
+			flagged = false;
+			revealed = false;
+		}
+	}
+};
+
+enum class Layout : uint8_t {
+	RowMajor = 0,
+	// 8x8 tiles stored one after the other, so that a vertical step stays within a tile
+	Tiled = 1,
+};
+
+inline constexpr std::array<const char*, 2> layout_names{"rows", "tiled"};
+
+// the cells of an m x n board. cell (i, j) is stored at row_base[i] + col_offset[j]: the tables
+// hold i * n and j for the row-major layout, and the tile and the offset within it for the tiled
+// one, so callers never see the layout and neither layout branches on it.
+class Grid {
+public:
+	Grid() = default;
+
+	// a grid whose cells and tables come from arena, or from board_allocate and the default
+	// resource when it is null
+	explicit Grid(std::pmr::memory_resource* arena)
+		: cells(arena), row_base(arena ? arena : std::pmr::get_default_resource()),
+		col_offset(arena ? arena : std::pmr::get_default_resource()) {}
+
+	Grid(size_t m, size_t n, Layout layout) {
+		assign(m, n, layout);
+	}
+
+	// resets every cell, reusing the storage when the size allows it
+	void assign(size_t m, size_t n, Layout layout) {
+		assign(m, n, layout, [](size_t, size_t) {});
+	}
+
+	// resets every cell and then calls fill(first, last) for the rows of each band, on the same
+	// thread that reset the band, so that a band is written by one thread from its first touch on
+	template <typename Fill>
+	void assign(size_t m, size_t n, Layout layout, Fill fill) {
+		this->m = m;
+		this->n = n;
+		this->layout = layout;
+		row_base.resize(m);
+		col_offset.resize(n);
+
+		if (layout == Layout::Tiled) {
+			size_t tiles_per_row = (n + 7) / 8;
+			for (size_t i = 0; i < m; i++) {
+				row_base[i] = (i / 8) * tiles_per_row * 64 + (i % 8) * 8;
+			}
+			for (size_t j = 0; j < n; j++) {
+				col_offset[j] = (j / 8) * 64 + j % 8;
+			}
+			cells.allocate((m + 7) / 8 * tiles_per_row * 64);
+		} else {
+			for (size_t i = 0; i < m; i++) {
+				row_base[i] = i * n;
+			}
+			for (size_t j = 0; j < n; j++) {
+				col_offset[j] = j;
+			}
+			cells.allocate(m * n);
+		}
+
+		for_each_band(m, band_granule(), m * n, [&](size_t first, size_t last) {
+			auto [begin, end] = band_storage(first, last);
+			std::fill(cells.begin() + begin, cells.begin() + end, Cell(CellType::EMPTY));
+			fill(first, last);
+		});
+	}
+
+	// bands of rows handed to for_each_band start on multiples of this, so that no two bands
+	// share a tile
+	size_t band_granule() const {
+		return layout == Layout::Tiled ? 8 : 1;
+	}
+
+	// the range of storage() that holds rows [first, last), padding included
+	std::pair<size_t, size_t> band_storage(size_t first, size_t last) const {
+		if (layout == Layout::Tiled) {
+			size_t tile_row = (n + 7) / 8 * 64;
+			return {first / 8 * tile_row, (last + 7) / 8 * tile_row};
+		}
+
+		return {first * n, last * n};
+	}
+
+	size_t rows() const {
+		return m;
+	}
+
+	size_t cols() const {
+		return n;
+	}
+
+	Layout cell_layout() const {
+		return layout;
+	}
+
+	Cell& at(size_t i, size_t j) {
+		return cells[row_base[i] + col_offset[j]];
+	}
+
+	const Cell& at(size_t i, size_t j) const {
+		return cells[row_base[i] + col_offset[j]];
+	}
+
+	// every stored cell in storage order, including the padding of partial tiles
+	BoardBuffer<Cell>& storage() {
+		return cells;
+	}
+
+	const BoardBuffer<Cell>& storage() const {
+		return cells;
+	}
+
+	// where the game's other memory should come from too
+	std::pmr::memory_resource* memory_resource() const {
+		return cells.memory_resource() ? cells.memory_resource() : std::pmr::get_default_resource();
+	}
+
+private:
+	size_t m = 0;
+	size_t n = 0;
+	Layout layout = Layout::RowMajor;
+	BoardBuffer<Cell> cells;
+	std::pmr::vector<uint32_t> row_base;
+	std::pmr::vector<uint32_t> col_offset;
+};
+
+constexpr bool outside(const Grid& grid, int i, int j) {
+	return i < 0 || j < 0 || i >= grid.rows() || j >= grid.cols();
+}
+
+template <typename Topo = Rectangle, typename Predicate>
+constexpr uint32_t count_neighbors(const Grid& grid, int i, int j, Predicate predicate) {
+	if (outside(grid, i, j)) {
+		return 0;
+	}
+
+	uint32_t result = 0;
+
+	Topo::for_each_adjacent(grid.rows(), grid.cols(), i, j, [&](int a, int b) {
+		result += predicate(grid.at(a, b));
+	});
+
+	return result;
+}
+
+template <typename Topo = Rectangle>
+inline uint32_t count_bomb_neighbors(const Grid& grid, int i, int j) {
+	MINES_COUNT(NeighborScans, 1);
+	return count_neighbors<Topo>(grid, i, j, [](Cell cell) {
+			return cell.type == CellType::BOMB;
+	});
+}
+
+template <typename Topo = Rectangle>
+inline uint32_t count_flagged_neighbors(const Grid& grid, int i, int j, uint16_t epoch) {
+	MINES_COUNT(NeighborScans, 1);
+	return count_neighbors<Topo>(grid, i, j, [epoch](Cell cell) { return cell.is_flagged(epoch); });
+}
+
+// splitmix64 finaliser; bombs are drawn from it as a counter-based generator,
+// so a board is a pure function of its seed and every game can be replayed
+constexpr uint64_t mix64(uint64_t x) {
+	x += 0x9e3779b97f4a7c15ull;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+	return x ^ (x >> 31);
+}
+
+inline bool is_bomb_at(uint64_t seed, uint64_t index, float bomb_likelihood) {
+	return (mix64(seed ^ mix64(index)) % 100) / 100.0f <= bomb_likelihood;
+}
+
+struct Journal;
+struct ReplayWriter;
+
+enum class GameState {
+	OVER,
+	ACTIVE,
+};
+
+// the counters are only ever changed through set_bomb, set_flagged and set_revealed,
+// so they are exact and every query on them is O(1)
+struct Game {
+	// the largest board a log or a file may describe: well inside the 32-bit indices of
+	// last_revealed, and already a couple of gigabytes of cells
+	static constexpr size_t max_cells = size_t(1) << 28;
+
+	uint64_t seed;
+	float bomb_likelihood;
+	uint32_t count_bombs;
+	uint32_t count_flagged;
+	// flags that sit on a bomb
+	uint32_t count_correct_flags;
+	// revealed cells that are not bombs
+	uint32_t count_revealed;
+
+	bool first_move;
+	GameState state;
+	Topology topology = Topology::Rectangle;
+	uint16_t epoch = 0;
+	Grid grid;
+	// row-major indices of the cells revealed by the last try_reveal, in no particular order
+	std::pmr::vector<uint32_t> last_revealed;
+	ReplayWriter* recorder = nullptr;
+	Journal* journal = nullptr;
+
+	// a game on an arena takes its grid, its last_revealed and the worklists of its moves from
+	// there, so that it is freed all at once with the arena. it must not outlive the arena
+	Game(size_t m, size_t n, float bomb_likelihood, uint64_t seed, Layout layout = Layout::RowMajor,
+		std::pmr::memory_resource* arena = nullptr)
+		: seed(seed), bomb_likelihood(bomb_likelihood), first_move(true), state(GameState::ACTIVE),
+		grid(arena), last_revealed(grid.memory_resource())
+	{
+		fill_grid(m, n, layout);
+	}
+
+	// reuses the cells already allocated when the size allows it
+	void fill_grid(size_t m, size_t n, Layout layout) {
+		epoch = 0;
+		count_bombs = 0;
+		count_flagged = 0;
+		count_correct_flags = 0;
+		count_revealed = 0;
+
+		// each band is drawn right after it is reset, so a bomb only moves count_bombs
+		std::atomic<uint32_t> bombs{0};
+		grid.assign(m, n, layout, [&](size_t first, size_t last) {
+			uint32_t band_bombs = 0;
+			for (size_t i = first; i < last; i++) {
+				for (size_t j = 0; j < n; j++) {
+					bool bomb = is_bomb_at(seed, i * n + j, bomb_likelihood);
+					grid.at(i, j).type = bomb ? CellType::BOMB : CellType::EMPTY;
+					band_bombs += bomb;
+				}
+			}
+			bombs.fetch_add(band_bombs, std::memory_order_relaxed);
+		});
+		count_bombs = bombs.load(std::memory_order_relaxed);
+	}
+
+	// a fresh board of the same size drawn from another seed, without reallocating the grid
+	void new_board(uint64_t board_seed) {
+		seed = board_seed;
+		first_move = true;
+		state = GameState::ACTIVE;
+		fill_grid(grid.rows(), grid.cols(), grid.cell_layout());
+	}
+
+	// a board the topology does not fit keeps the one it has
+	bool set_topology(Topology value) {
+		if (!fits(value, grid.rows(), grid.cols())) {
+			return false;
+		}
+
+		topology = value;
+		return true;
+	}
+
+	bool outside(int i, int j) const {
+		return ::outside(grid, i, j);
+	}
+
+	bool is_bomb(size_t i, size_t j) const {
+		return grid.at(i, j).type == CellType::BOMB;
+	}
+
+	bool is_flagged(size_t i, size_t j) const {
+		return grid.at(i, j).is_flagged(epoch);
+	}
+
+	bool is_revealed(size_t i, size_t j) const {
+		return grid.at(i, j).is_revealed(epoch);
+	}
+
+	size_t count_cells() const {
+		return grid.rows() * grid.cols();
+	}
+
+	size_t safe_cells_left() const {
+		return count_cells() - count_bombs - count_revealed;
+	}
+
+	uint32_t bombs_left() const {
+		return count_flagged >= count_bombs ? 0 : count_bombs - count_flagged;
+	}
+
+	void set_bomb(size_t i, size_t j, bool value) {
+		Cell& cell = grid.at(i, j);
+		if ((cell.type == CellType::BOMB) == value) {
+			return;
+		}
+
+		int delta = value ? 1 : -1;
+		cell.type = value ? CellType::BOMB : CellType::EMPTY;
+		count_bombs += delta;
+		count_correct_flags += cell.is_flagged(epoch) ? delta : 0;
+		count_revealed -= cell.is_revealed(epoch) ? delta : 0;
+	}
+
+	void set_flagged(size_t i, size_t j, bool value) {
+		Cell& cell = grid.at(i, j);
+		cell.refresh(epoch);
+		if (cell.flagged == value) {
+			return;
+		}
+
+		int delta = value ? 1 : -1;
+		cell.flagged = value;
+		count_flagged += delta;
+		count_correct_flags += (cell.type == CellType::BOMB) ? delta : 0;
+	}
+
+	// returns whether the cell was hidden
+	bool set_revealed(size_t i, size_t j) {
+		Cell& cell = grid.at(i, j);
+		cell.refresh(epoch);
+		if (cell.revealed) {
+			return false;
+		}
+
+		cell.revealed = true;
+		count_revealed += (cell.type != CellType::BOMB);
+		return true;
+	}
+
+	void clear_last_revealed() {
+		last_revealed.clear();
+	}
+
+	void add_last_revealed(size_t i, size_t j) {
+		last_revealed.push_back(i * grid.cols() + j);
+	}
+
+	void set_hidden(size_t i, size_t j) {
+		Cell& cell = grid.at(i, j);
+		if (!cell.is_revealed(epoch)) {
+			return;
+		}
+
+		cell.revealed = false;
+		count_revealed -= (cell.type != CellType::BOMB);
+	}
+
+	// O(1): moving to the next epoch hides and unflags every cell at once. only when the
+	// epoch wraps around are the cells cleared for real, so old tags cannot come back to life
+	void restart() {
+		first_move = true;
+		state = GameState::ACTIVE;
+		count_flagged = 0;
+		count_correct_flags = 0;
+		count_revealed = 0;
+
+		if (++epoch == 0) {
+			for (auto& cell : grid.storage()) {
+				cell.epoch = 0;
+				cell.flagged = false;
+				cell.revealed = false;
+			}
+		}
+	}
+};
+
+inline bool is_won(const Game& game) {
+	return game.safe_cells_left() == 0;
+}
+
+// the neighbourhood primitives of the move rules, dispatched on the game's topology
+inline uint32_t count_bomb_neighbors(const Game& game, int i, int j) {
+	return with_topology(game.topology, [&](auto topo) {
+		return count_bomb_neighbors<decltype(topo)>(game.grid, i, j);
+	});
+}
+
+inline uint32_t count_flagged_neighbors(const Game& game, int i, int j) {
+	return with_topology(game.topology, [&](auto topo) {
+		return count_flagged_neighbors<decltype(topo)>(game.grid, i, j, game.epoch);
+	});
+}
+
+template <typename F>
+void for_each_adjacent(const Game& game, int i, int j, F f) {
+	with_topology(game.topology, [&](auto topo) {
+		decltype(topo)::for_each_adjacent(game.grid.rows(), game.grid.cols(), i, j, f);
+	});
+}
+
+// recounts everything with a full scan, to check the counters in debug builds
+bool counters_consistent(const Game& game);
+
+std::ostream& operator<<(std::ostream& os, const Game& game);
+
+enum class PlayerMove : uint8_t {
+	Success,
+	NA,
+	LosingMove,
+	OutBounds,
+};
+
+// does nothing for a cell off the board
+void expand(Game& game, int i, int j);
+
+// the rules of rules.hpp on a Game, try_reveal traced
+PlayerMove try_reveal(Game& game, const std::pair<int, int>& place);
+
+PlayerMove try_set_flag(Game& game, const std::pair<int, int>& place, bool value);
+
+// the first reveal of a game is never a bomb
+PlayerMove play_reveal(Game& game, const std::pair<int, int>& place);
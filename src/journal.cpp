@@ -0,0 +1,102 @@
+#include "journal.hpp"
+
+JournalEntry Journal::begin(const Game& game, Opcode op, const std::pair<int, int>& place) const {
+	JournalEntry entry;
+	entry.op = op;
+	entry.place = place;
+	entry.first_move_before = game.first_move;
+	entry.state_before = game.state;
+
+	auto [i, j] = place;
+	if (!outside(game.grid, i, j)) {
+		entry.flagged_before = game.is_flagged(i, j);
+		entry.bomb_before = game.grid.at(i, j).type == CellType::BOMB;
+	}
+
+	return entry;
+}
+
+void Journal::commit(Game& game, JournalEntry entry) {
+	auto [i, j] = entry.place;
+	bool inside = !outside(game.grid, i, j);
+	entry.bomb_cleared = inside && entry.bomb_before && game.grid.at(i, j).type != CellType::BOMB;
+
+	bool changed = !game.last_revealed.empty() || entry.bomb_cleared
+		|| (inside && entry.flagged_before != game.is_flagged(i, j))
+		|| entry.first_move_before != game.first_move || entry.state_before != game.state;
+	if (!changed) {
+		return;
+	}
+
+	if (!game.last_revealed.empty()) {
+		encode_spans(entry.revealed, game.last_revealed);
+		entry.revealed.shrink_to_fit();
+	}
+
+	if (!redoing) {
+		for (auto& stale : undone) {
+			bytes -= stale.bytes();
+		}
+		undone.clear();
+	}
+
+	bytes += entry.bytes();
+	done.push_back(std::move(entry));
+	while (bytes > budget && !done.empty()) {
+		bytes -= done.front().bytes();
+		done.pop_front();
+	}
+}
+
+void Journal::clear() {
+	done.clear();
+	undone.clear();
+	bytes = 0;
+}
+
+bool undo(Game& game) {
+	Journal* journal = game.journal;
+	if (!journal || journal->done.empty()) {
+		return false;
+	}
+
+	JournalEntry entry = std::move(journal->done.back());
+	journal->done.pop_back();
+
+	size_t n = game.grid.cols();
+	game.last_revealed.clear();
+	for_each_span_cell(entry.revealed, [&game, n](uint32_t cell) {
+		game.set_hidden(cell / n, cell % n);
+		game.last_revealed.push_back(cell);
+	});
+
+	auto [i, j] = entry.place;
+	if (entry.bomb_cleared) {
+		game.set_bomb(i, j, true);
+	}
+
+	if (!outside(game.grid, i, j)) {
+		game.set_flagged(i, j, entry.flagged_before);
+	}
+
+	game.first_move = entry.first_move_before;
+	game.state = entry.state_before;
+	journal->undone.push_back(std::move(entry));
+	return true;
+}
+
+bool redo(Game& game) {
+	Journal* journal = game.journal;
+	if (!journal || journal->undone.empty()) {
+		return false;
+	}
+
+	JournalEntry entry = std::move(journal->undone.back());
+	journal->undone.pop_back();
+	journal->bytes -= entry.bytes();
+
+	journal->redoing = true;
+	play_move(game, entry.op, entry.place);
+	journal->redoing = false;
+	return true;
+}
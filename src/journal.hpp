@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "game.hpp"
+#include "protocol.hpp"
+
+// one undoable move. the cells it revealed are kept as encode_spans output rather than
+// as a copy of the grid, so undoing it costs time and memory proportional to what it changed.
+struct JournalEntry {
+	Opcode op = Opcode::End;
+	std::pair<int, int> place;
+	std::string revealed;
+	bool flagged_before = false;
+	bool bomb_before = false;
+	bool bomb_cleared = false;
+	bool first_move_before = false;
+	GameState state_before = GameState::ACTIVE;
+
+	size_t bytes() const {
+		return sizeof(JournalEntry) + revealed.capacity();
+	}
+};
+
+// undo and redo stacks of moves, the oldest moves are forgotten once the entries
+// together take more than budget bytes
+struct Journal {
+	size_t budget;
+	size_t bytes = 0;
+	bool redoing = false;
+	std::deque<JournalEntry> done;
+	std::vector<JournalEntry> undone;
+
+	explicit Journal(size_t budget)
+		: budget(budget) {}
+
+	JournalEntry begin(const Game& game, Opcode op, const std::pair<int, int>& place) const;
+	// sorts game.last_revealed while encoding it
+	void commit(Game& game, JournalEntry entry);
+	void clear();
+};
+
+bool undo(Game& game);
+bool redo(Game& game);
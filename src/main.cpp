@@ -0,0 +1,375 @@
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "board_memory.hpp"
+#include "command.hpp"
+#include "console.hpp"
+#include "corpus.hpp"
+#include "endless.hpp"
+#include "flood.hpp"
+#include "game.hpp"
+#include "journal.hpp"
+#include "protocol.hpp"
+#include "render.hpp"
+#include "replay.hpp"
+#include "simulate.hpp"
+#include "snapshot.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+
+void print_welcome() {
+	std::cout << "Welcome to B O M B S\n";
+}
+
+bool accept_input(Game& game) {
+	std::string ln;
+	Command command;
+	while (command.empty()) {
+		if (!std::getline(std::cin, ln)) {
+			// end of input, nothing more can be played
+			game.state = GameState::OVER;
+			return false;
+		}
+
+		MINES_TRACE_SCOPE(Parse);
+		command = to_command(ln);
+	}
+
+	auto option = command_table.find(std::string_view(command.front()));
+	if (option == command_table.end()) {
+		print_parse_error(command, ParseError::UnknownCommand);
+		return false;
+	}
+
+	MINES_TIME_COMMAND();
+	MINES_TRACE_SCOPE(Dispatch);
+	return option->second(game, command);
+}
+
+bool prompt(Game& game) {
+	std::cout << "Please enter a command or \"help\" for a list of commands.\n";
+	return accept_input(game);
+}
+
+void simulate(uint64_t games, uint64_t seed, Topology topology) {
+	for (auto& preset : presets) {
+		uint64_t preset_games = std::max<uint64_t>(1, games / preset.games_divisor);
+		auto start = std::chrono::steady_clock::now();
+		auto [wins, moves] = simulate_preset(preset, preset_games, seed, topology);
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << preset.name << ": " << preset_games << " games, " << wins << " won, "
+			<< moves << " moves in " << seconds << "s (" << moves / seconds << " moves/s)\n";
+	}
+
+#ifdef MINES_STATS
+	stats::report(std::cout);
+#endif
+}
+
+struct Options {
+	std::vector<std::string> args;
+	bool binary = false;
+	uint64_t seed = time(nullptr);
+	std::string record_path;
+	std::string replay_path;
+	std::string load_path;
+	std::string corpus_path;
+	uint64_t corpus_size = 0;
+	uint64_t board = 0;
+	bool annotate = false;
+	bool endless = false;
+	uint64_t simulate_games = 0;
+	std::string trace_path;
+	size_t undo_budget = 1 << 20;
+	std::string topology = topology_names[0];
+	std::string layout = layout_names[0];
+	std::string pages = page_policy_names[0];
+};
+
+Options parse_options(int argc, char **argv) {
+	Options options;
+	for (int k = 1; k < argc; k++) {
+		std::string arg = argv[k];
+		if (arg == "--binary") {
+			options.binary = true;
+		} else if (arg == "--seed" && k + 1 < argc) {
+			options.seed = std::stoull(argv[++k]);
+		} else if (arg == "--record" && k + 1 < argc) {
+			options.record_path = argv[++k];
+		} else if (arg == "--replay" && k + 1 < argc) {
+			options.replay_path = argv[++k];
+		} else if (arg == "--load" && k + 1 < argc) {
+			options.load_path = argv[++k];
+		} else if (arg == "--build-corpus" && k + 2 < argc) {
+			options.corpus_path = argv[++k];
+			options.corpus_size = std::stoull(argv[++k]);
+		} else if (arg == "--corpus" && k + 1 < argc) {
+			options.corpus_path = argv[++k];
+		} else if (arg == "--board" && k + 1 < argc) {
+			options.board = std::stoull(argv[++k]);
+		} else if (arg == "--annotate") {
+			options.annotate = true;
+		} else if (arg == "--endless") {
+			options.endless = true;
+		} else if (arg == "--simulate" && k + 1 < argc) {
+			options.simulate_games = std::stoull(argv[++k]);
+		} else if (arg == "--trace" && k + 1 < argc) {
+			options.trace_path = argv[++k];
+		} else if (arg == "--undo-budget" && k + 1 < argc) {
+			options.undo_budget = std::stoull(argv[++k]);
+		} else if (arg == "--topology" && k + 1 < argc) {
+			options.topology = argv[++k];
+		} else if (arg == "--layout" && k + 1 < argc) {
+			options.layout = argv[++k];
+		} else if (arg == "--pages" && k + 1 < argc) {
+			options.pages = argv[++k];
+		} else if (arg == "--threads" && k + 1 < argc) {
+			flood_threads = std::stoul(argv[++k]);
+			fill_threads = flood_threads;
+		} else {
+			options.args.push_back(arg);
+		}
+	}
+
+	return options;
+}
+
+// looks name up in names, which are indexed by the values of Enum
+template <typename Enum, size_t N>
+bool parse_name(const std::array<const char*, N>& names, const std::string& name, Enum& value) {
+	for (size_t k = 0; k < names.size(); k++) {
+		if (name == names[k]) {
+			value = static_cast<Enum>(k);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+Game from_cmd_ln_args(const Options& options, Topology topology, Layout layout) {
+	size_t m = 8;
+	size_t n = 8;
+	float likelihood = .12;
+	if (options.args.size() >= 3) {
+		m = std::min(10, std::stoi(options.args[0]));
+		n = std::min(10, std::stoi(options.args[1]));
+		likelihood = std::max(0.0f, std::min(.50f, (float) std::stod(options.args[2])));
+	}
+
+	// a torus narrower than 3 cells would see its neighbours twice
+	if (topology == Topology::Torus) {
+		m = std::max(Torus::min_size, m);
+		n = std::max(Torus::min_size, n);
+	}
+
+	Game game(m, n, likelihood, options.seed, layout);
+	game.set_topology(topology);
+	return game;
+}
+
+// the endless mode: moves take any board coordinates, negative ones included, and the board is
+// shown through a window that "view i j" centres on (i, j)
+int play_endless(const Options& options) {
+	float likelihood = .12;
+	if (!options.args.empty()) {
+		likelihood = std::max(0.0f, std::min(.50f, std::stof(options.args[0])));
+	}
+
+	EndlessGame game(likelihood, options.seed);
+	Viewport view{-8, -16, 16, 32};
+	std::pmr::vector<std::pair<int, int>> places;
+	std::string ln;
+	std::cout << "Endless board: \"reveal\", \"flag\" and \"unflag\" take any coordinates short of the int limits, \"view i j\" moves the window, "
+		<< "\"memory\" shows the explored chunks and \"exit\" ends the game.\n";
+	render(std::cout, game, view, RenderMode::Ansi);
+
+	while (game.state != GameState::OVER && std::getline(std::cin, ln)) {
+		Command command = to_command(ln);
+		if (command.empty()) {
+			continue;
+		}
+
+		std::string_view word = command.front();
+		if (word == "exit") {
+			break;
+		}
+
+		if (word == "memory") {
+			std::cout << "The board has " << game.count_chunks() << " chunks of " << EndlessGame::chunk_size << "x"
+				<< EndlessGame::chunk_size << " cells, " << game.count_chunks() * sizeof(EndlessGame::Chunk) << " bytes.\n";
+			continue;
+		}
+
+		ParseError error = ParseError::UnknownCommand;
+		if (word == "reveal" || word == "flag" || word == "unflag" || word == "view") {
+			error = parse_places(command, places);
+		}
+		if (error != ParseError::None) {
+			print_parse_error(command, error);
+			continue;
+		}
+
+		for (auto [i, j] : places) {
+			if (word == "view") {
+				// every cell in the window must be on the board, or its neighbour counts would overflow
+				int64_t top = int64_t(i) - view.rows / 2;
+				int64_t left = int64_t(j) - view.cols / 2;
+				if (game.outside(top, left) || game.outside(top + view.rows - 1, left + view.cols - 1)) {
+					std::cout << "Cannot center the view on " << i << ", " << j << ", it would run off the board.\n";
+					continue;
+				}
+				view.top = static_cast<int>(top);
+				view.left = static_cast<int>(left);
+			} else if (game.state != GameState::OVER) {
+				Opcode op = word == "reveal" ? Opcode::Reveal : (word == "flag" ? Opcode::Flag : Opcode::Unflag);
+				if (apply_move(game, op, {i, j}) == PlayerMove::OutBounds) {
+					std::cout << "Cell " << i << ", " << j << " is off the board, which ends one cell short of the int limits.\n";
+				}
+			}
+		}
+
+		render(std::cout, game, view, RenderMode::Ansi);
+	}
+
+	std::cout << "Game over, " << game.count_revealed << " cells revealed.\n";
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	Options options = parse_options(argc, argv);
+	if (!options.trace_path.empty()) {
+#ifdef MINES_TRACE
+		trace::start(options.trace_path);
+#else
+		std::cout << "--trace needs a build configured with -DMINES_TRACE=ON.\n";
+		return 1;
+#endif
+	}
+
+	if (!options.replay_path.empty()) {
+		ReplayResult result = replay(options.replay_path);
+		if (!result.complete) {
+			std::cout << "Replay log \"" << options.replay_path << "\" is unreadable or truncated after " << result.moves << " moves.\n";
+			return 1;
+		}
+
+		std::cout << "Replayed " << result.moves << " moves in " << result.seconds << "s, final state " << (result.matched ? "matches" : "does NOT match") << " the log.\n";
+		return result.matched ? 0 : 1;
+	}
+
+	if (options.corpus_size) {
+		if (options.args.size() < 3) {
+			std::cout << "--build-corpus expects the rows, columns and bomb likelihood of the boards.\n";
+			return 1;
+		}
+
+		return build_corpus(options.corpus_path, std::stoul(options.args[0]), std::stoul(options.args[1]),
+			std::stof(options.args[2]), options.seed, options.corpus_size, options.annotate) ? 0 : 1;
+	}
+
+	Topology topology;
+	if (!parse_name(topology_names, options.topology, topology)) {
+		std::cout << "Unknown topology \"" << options.topology << "\", expected rectangle, torus or hex.\n";
+		return 1;
+	}
+
+	Layout layout;
+	if (!parse_name(layout_names, options.layout, layout)) {
+		std::cout << "Unknown layout \"" << options.layout << "\", expected rows or tiled.\n";
+		return 1;
+	}
+
+	if (!parse_name(page_policy_names, options.pages, board_pages)) {
+		std::cout << "Unknown page policy \"" << options.pages << "\", expected default, thp or hugetlb.\n";
+		return 1;
+	}
+
+	if (options.simulate_games) {
+		simulate(options.simulate_games, options.seed, topology);
+		return 0;
+	}
+
+	if (options.endless) {
+		return play_endless(options);
+	}
+
+	Game game = from_cmd_ln_args(options, topology, layout);
+	if (!options.corpus_path.empty()) {
+		CorpusView view;
+		if (!view.open(options.corpus_path) || options.board >= view.header->count) {
+			std::cout << "Failed loading board " << options.board << " from \"" << options.corpus_path << "\".\n";
+			return 1;
+		}
+
+		game = load_corpus_board(view, options.board, layout);
+		if (!game.set_topology(topology)) {
+			std::cout << "Board " << options.board << " from \"" << options.corpus_path << "\" is too small for a torus.\n";
+			return 1;
+		}
+	}
+
+	if (!options.load_path.empty()) {
+		if (!options.record_path.empty()) {
+			std::cout << "--load cannot be combined with --record, a replay log starts from a seeded board.\n";
+			return 1;
+		}
+
+		SnapshotView view;
+		if (!view.open(options.load_path)) {
+			std::cout << "Failed loading a game from \"" << options.load_path << "\".\n";
+			return 1;
+		}
+
+		game = load_snapshot(view, layout);
+	}
+
+	Journal journal(options.undo_budget);
+	game.journal = &journal;
+
+	std::unique_ptr<ReplayWriter> recorder;
+	if (!options.record_path.empty()) {
+		recorder = std::make_unique<ReplayWriter>(options.record_path, game);
+		game.recorder = recorder.get();
+	}
+
+	if (options.binary) {
+		std::ios::sync_with_stdio(false);
+		serve_binary(game, std::cin, std::cout);
+	} else {
+		print_welcome();
+		std::cout << game << '\n';
+
+		while (game.state != GameState::OVER) {
+			bool accepted_input = prompt(game);
+
+			{
+				MINES_TRACE_SCOPE(WinCheck);
+				if (is_won(game)) {
+					game.state = GameState::OVER;
+				}
+			}
+
+			if (accepted_input) {
+				MINES_TRACE_SCOPE(Render);
+				std::cout << game << '\n';
+			}
+		}
+	}
+
+	if (recorder) {
+		recorder->finish(game);
+	}
+
+	return 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct MappedFile {
+	void* data = MAP_FAILED;
+	size_t size = 0;
+
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile() {
+		if (data != MAP_FAILED) {
+			munmap(data, size);
+		}
+	}
+
+	// maps the whole file read-only, fails on files shorter than min_size
+	bool open(const std::string& path, size_t min_size) {
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return false;
+		}
+
+		struct stat st;
+		if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= min_size && st.st_size > 0) {
+			size = st.st_size;
+			data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+		close(fd);
+
+		return data != MAP_FAILED;
+	}
+};
@@ -0,0 +1,7 @@
+#include "metrics.hpp"
+
+BoardMetrics compute_metrics(const Game& game) {
+	return compute_metrics(game.grid.rows(), game.grid.cols(), [&game](size_t i, size_t j) {
+		return game.grid.at(i, j).type == CellType::BOMB;
+	});
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "game.hpp"
+
+// difficulty metrics under this engine's reveal rules: a click on a zero cell reveals its
+// 4-connected zero region (an opening) and that region's 4-neighbours, every other safe cell
+// takes a click of its own. 3BV is the openings plus those isolated cells.
+struct BoardMetrics {
+	uint32_t bbbv = 0;
+	uint32_t openings = 0;
+	uint32_t isolated = 0;
+};
+
+// one pass over the rows: counts are kept for three rows at a time and zero cells are
+// labelled with a union-find over the labels of the current and previous row
+template <typename IsBomb>
+BoardMetrics compute_metrics(size_t m, size_t n, IsBomb is_bomb) {
+	constexpr uint8_t bomb = 0xff;
+	constexpr uint32_t none = 0xffffffff;
+
+	std::vector<uint8_t> counts[3] = {std::vector<uint8_t>(n), std::vector<uint8_t>(n), std::vector<uint8_t>(n)};
+	std::vector<uint32_t> labels[2] = {std::vector<uint32_t>(n, none), std::vector<uint32_t>(n, none)};
+	std::vector<uint32_t> parent;
+
+	auto fill_counts = [&](size_t i, std::vector<uint8_t>& row) {
+		for (size_t j = 0; j < n; j++) {
+			if (is_bomb(i, j)) {
+				row[j] = bomb;
+				continue;
+			}
+
+			uint8_t count = 0;
+			for (size_t a = (i ? i - 1 : 0); a <= std::min(i + 1, m - 1); a++) {
+				for (size_t b = (j ? j - 1 : 0); b <= std::min(j + 1, n - 1); b++) {
+					count += is_bomb(a, b);
+				}
+			}
+			row[j] = count;
+		}
+	};
+
+	auto find = [&parent](uint32_t label) {
+		while (parent[label] != label) {
+			label = parent[label] = parent[parent[label]];
+		}
+		return label;
+	};
+
+	BoardMetrics metrics;
+	if (!m || !n) {
+		return metrics;
+	}
+
+	std::vector<uint8_t>* prev = &counts[0];
+	std::vector<uint8_t>* cur = &counts[1];
+	std::vector<uint8_t>* next = &counts[2];
+	fill_counts(0, *cur);
+
+	for (size_t i = 0; i < m; i++) {
+		if (i + 1 < m) {
+			fill_counts(i + 1, *next);
+		}
+
+		auto& up = labels[(i + 1) % 2];
+		auto& row = labels[i % 2];
+		for (size_t j = 0; j < n; j++) {
+			uint8_t count = (*cur)[j];
+			row[j] = none;
+			if (count == bomb) {
+				continue;
+			}
+
+			if (count) {
+				bool touches_zero = (j && !(*cur)[j - 1]) || (j + 1 < n && !(*cur)[j + 1])
+					|| (i && !(*prev)[j]) || (i + 1 < m && !(*next)[j]);
+				metrics.isolated += !touches_zero;
+				continue;
+			}
+
+			uint32_t left = j ? row[j - 1] : none;
+			uint32_t above = i ? up[j] : none;
+			if (left == none && above == none) {
+				row[j] = parent.size();
+				parent.push_back(row[j]);
+				metrics.openings++;
+			} else if (left == none || above == none) {
+				row[j] = find(left == none ? above : left);
+			} else {
+				uint32_t a = find(left);
+				uint32_t b = find(above);
+				if (a != b) {
+					parent[b] = a;
+					metrics.openings--;
+				}
+				row[j] = a;
+			}
+		}
+
+		std::swap(prev, cur);
+		std::swap(cur, next);
+	}
+
+	metrics.bbbv = metrics.openings + metrics.isolated;
+	return metrics;
+}
+
+BoardMetrics compute_metrics(const Game& game);
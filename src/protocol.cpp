@@ -0,0 +1,131 @@
+#include "protocol.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "journal.hpp"
+#include "replay.hpp"
+#include "rules.hpp"
+
+bool read_varint(std::istream& is, uint32_t& value) {
+	value = 0;
+	for (int shift = 0; shift < 35; shift += 7) {
+		int byte = is.get();
+		if (byte == EOF) {
+			return false;
+		}
+
+		value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool read_varint(std::string_view& in, uint32_t& value) {
+	value = 0;
+	for (int shift = 0; shift < 35 && !in.empty(); shift += 7) {
+		uint8_t byte = in.front();
+		in.remove_prefix(1);
+
+		value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void encode_move(std::string& out, Opcode op, const std::pair<int, int>& place) {
+	out.push_back(static_cast<char>(op));
+	write_varint(out, place.first);
+	write_varint(out, place.second);
+}
+
+bool decode_move(std::istream& is, Opcode& op, std::pair<int, int>& place) {
+	int byte = is.get();
+	uint32_t i, j;
+	if (byte == EOF || !read_varint(is, i) || !read_varint(is, j)) {
+		return false;
+	}
+
+	op = static_cast<Opcode>(byte);
+	place = {static_cast<int>(i), static_cast<int>(j)};
+	return true;
+}
+
+void encode_spans(std::string& out, std::pmr::vector<uint32_t>& cells) {
+	// the journal has usually sorted the cells of this move already
+	if (!std::is_sorted(cells.begin(), cells.end())) {
+		std::sort(cells.begin(), cells.end());
+	}
+
+	// a span starts wherever a cell does not follow on from the one before it
+	uint32_t count = 0;
+	for (size_t k = 0; k < cells.size(); k++) {
+		count += !k || cells[k] != cells[k - 1] + 1;
+	}
+
+	write_varint(out, count);
+	uint32_t end = 0;
+	for (size_t k = 0; k < cells.size();) {
+		size_t first = k;
+		while (++k < cells.size() && cells[k] == cells[k - 1] + 1) {
+		}
+
+		write_varint(out, cells[first] - end);
+		write_varint(out, k - first);
+		end = cells[first] + (k - first);
+	}
+}
+
+PlayerMove apply_move(Game& game, Opcode op, const std::pair<int, int>& place) {
+	if (game.recorder) {
+		game.recorder->record(op, place);
+	}
+
+	return play_move(game, op, place);
+}
+
+PlayerMove play_move(Game& game, Opcode op, const std::pair<int, int>& place) {
+	if (op == Opcode::Undo || op == Opcode::Redo) {
+		bool done = (op == Opcode::Undo) ? undo(game) : redo(game);
+		assert(counters_consistent(game));
+		return done ? PlayerMove::Success : PlayerMove::NA;
+	}
+
+	JournalEntry entry;
+	if (game.journal) {
+		entry = game.journal->begin(game, op, place);
+	}
+
+	PlayerMove result = rules::apply_move(game, op, place);
+	if (game.journal && op == Opcode::Restart) {
+		game.journal->clear();
+	} else if (game.journal) {
+		game.journal->commit(game, std::move(entry));
+	}
+
+	assert(counters_consistent(game));
+	return result;
+}
+
+void serve_binary(Game& game, std::istream& is, std::ostream& os) {
+	Opcode op;
+	std::pair<int, int> place;
+	std::string frame;
+
+	while (game.state != GameState::OVER && decode_move(is, op, place)) {
+		PlayerMove result = apply_move(game, op, place);
+
+		frame.clear();
+		frame.push_back(static_cast<char>(result));
+		frame.push_back(static_cast<char>(game.state));
+		encode_spans(frame, game.last_revealed);
+		os.write(frame.data(), frame.size());
+		os.flush();
+	}
+}
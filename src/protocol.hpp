@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "game.hpp"
+
+// binary protocol: a frame is one opcode byte followed by the row and column as varints.
+// the response is the PlayerMove code, the GameState, and the cells revealed by the move
+// as a varint count of spans, each span being (gap from the end of the previous span, length).
+// Undo and Redo ignore the place; after an Undo the spans are the cells hidden again.
+enum class Opcode : uint8_t {
+	End = 0,
+	Reveal = 1,
+	Flag = 2,
+	Unflag = 3,
+	Chord = 4,
+	Restart = 5,
+	Undo = 6,
+	Redo = 7,
+};
+
+inline void write_varint(std::string& out, uint32_t value) {
+	while (value >= 0x80) {
+		out.push_back(static_cast<char>(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<char>(value));
+}
+
+bool read_varint(std::istream& is, uint32_t& value);
+bool read_varint(std::string_view& in, uint32_t& value);
+
+void encode_move(std::string& out, Opcode op, const std::pair<int, int>& place);
+
+bool decode_move(std::istream& is, Opcode& op, std::pair<int, int>& place);
+
+// sorts cells in place, so that a cascade is neither copied nor buffered on its way out
+void encode_spans(std::string& out, std::pmr::vector<uint32_t>& cells);
+
+// calls f with every row-major index encoded by encode_spans, in increasing order
+template <typename F>
+void for_each_span_cell(std::string_view in, F f) {
+	uint32_t count, gap, length;
+	if (!read_varint(in, count)) {
+		return;
+	}
+
+	uint32_t end = 0;
+	for (uint32_t s = 0; s < count && read_varint(in, gap) && read_varint(in, length); s++) {
+		for (uint32_t cell = end + gap; cell < end + gap + length; cell++) {
+			f(cell);
+		}
+		end += gap + length;
+	}
+}
+
+// records the move if a recorder is attached, then plays it
+PlayerMove apply_move(Game& game, Opcode op, const std::pair<int, int>& place);
+
+// plays one move, journaling it if a journal is attached
+PlayerMove play_move(Game& game, Opcode op, const std::pair<int, int>& place);
+
+void serve_binary(Game& game, std::istream& is, std::ostream& os);
@@ -0,0 +1,229 @@
+#include "render.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "adjacency.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// cell codes: 0 to 8 are revealed counts, then the three glyphs that hide the count
+enum Code : uint8_t {
+	Hidden = 9,
+	Flag = 10,
+	Bomb = 11,
+};
+
+constexpr char ascii_glyphs[16] = {' ', '1', '2', '3', '4', '5', '6', '7', '8', '.', 'F', 'B'};
+
+// each code's glyph with its escapes and the trailing separator, at most 16 bytes
+struct Slot {
+	char bytes[16];
+	uint8_t size;
+};
+
+std::array<Slot, 12> make_ansi_slots() {
+	std::array<Slot, 12> slots{};
+	auto set = [&slots](uint8_t code, const std::string& text) {
+		std::memcpy(slots[code].bytes, text.data(), text.size());
+		slots[code].size = text.size();
+	};
+
+	set(0, "\033[47m \033[0m ");
+	for (uint8_t count = 1; count <= 8; count++) {
+		set(count, "\033[43;30;1m" + std::to_string(count) + "\033[0m ");
+	}
+	set(Hidden, ". ");
+	set(Flag, "\033[1;44mF\033[0m ");
+	set(Bomb, "\033[30;41;1mB\033[0m ");
+	return slots;
+}
+
+const std::array<Slot, 12> ansi_slots = make_ansi_slots();
+
+// the codes of row i, asking count for the bomb count of the cells that show one
+template <typename Count>
+void row_codes(const Game& game, bool won, size_t i, Count count, uint8_t* codes) {
+	bool over = game.state == GameState::OVER;
+	for (size_t j = 0; j < game.grid.cols(); j++) {
+		auto& cell = game.grid.at(i, j);
+		bool bomb = cell.type == CellType::BOMB;
+		if (cell.is_flagged(game.epoch) || (won && bomb)) {
+			codes[j] = Flag;
+		} else if (!over && !cell.is_revealed(game.epoch)) {
+			codes[j] = Hidden;
+		} else {
+			codes[j] = bomb ? static_cast<uint8_t>(Bomb) : static_cast<uint8_t>(count(i, j));
+		}
+	}
+}
+
+// writes a glyph and a space per code
+void ascii_scalar(const uint8_t* codes, size_t n, char* out) {
+	for (size_t j = 0; j < n; j++) {
+		out[2 * j] = ascii_glyphs[codes[j]];
+		out[2 * j + 1] = ' ';
+	}
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("ssse3"))) void ascii_ssse3(const uint8_t* codes, size_t n, char* out) {
+	const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ascii_glyphs));
+	const __m128i spaces = _mm_set1_epi8(' ');
+	size_t j = 0;
+	for (; j + 16 <= n; j += 16) {
+		__m128i glyphs = _mm_shuffle_epi8(table, _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + j)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * j), _mm_unpacklo_epi8(glyphs, spaces));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * j + 16), _mm_unpackhi_epi8(glyphs, spaces));
+	}
+
+	ascii_scalar(codes + j, n - j, out + 2 * j);
+}
+
+bool has_ssse3() {
+	static const bool result = __builtin_cpu_supports("ssse3");
+	return result;
+}
+#else
+bool has_ssse3() {
+	return false;
+}
+#endif
+
+void ascii_glyphs_of(const uint8_t* codes, size_t n, char* out) {
+#if defined(__x86_64__) || defined(__i386__)
+	if (has_ssse3()) {
+		ascii_ssse3(codes, n, out);
+		return;
+	}
+#endif
+
+	ascii_scalar(codes, n, out);
+}
+
+// appends value and then separator to line
+void append_number(std::pmr::string& line, int64_t value, const char* separator) {
+	char digits[24];
+	char* end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+	line.append(digits, end);
+	line += separator;
+}
+
+// appends the glyphs of a row of codes to line, returns the bytes written
+size_t append_glyphs(std::pmr::string& line, const uint8_t* codes, size_t n, RenderMode mode) {
+	size_t start = line.size();
+	if (mode == RenderMode::Ascii) {
+		line.resize(start + 2 * n);
+		ascii_glyphs_of(codes, n, line.data() + start);
+		return 2 * n;
+	}
+
+	// every slot is copied whole and the end moves on by its size, 16 bytes of slack cover the last one
+	line.resize(start + 16 * n + 16);
+	char* out = line.data() + start;
+	for (size_t j = 0; j < n; j++) {
+		const Slot& slot = ansi_slots[codes[j]];
+		std::memcpy(out, slot.bytes, sizeof(slot.bytes));
+		out += slot.size;
+	}
+	line.resize(out - line.data());
+	return out - (line.data() + start);
+}
+
+template <typename Topo, typename Count>
+void render_rows(std::ostream& os, const Game& game, RenderMode mode, Count count, std::pmr::memory_resource* scratch) {
+	size_t m = game.grid.rows();
+	size_t n = game.grid.cols();
+	bool won = is_won(game);
+
+	std::pmr::vector<uint8_t> codes(n, scratch);
+	std::pmr::string line(scratch);
+	// the label, the hex offset and the glyphs with their slack, so that line never grows
+	line.reserve(24 + 16 * n + 16);
+	for (size_t i = 0; i < m; i++) {
+		line.clear();
+		append_number(line, i, "  ");
+		// hex rows are offset by half a cell
+		if (Topo::kind == Topology::Hex && (i & 1)) {
+			line += ' ';
+		}
+
+		row_codes(game, won, i, count, codes.data());
+		[[maybe_unused]] size_t glyph_bytes = append_glyphs(line, codes.data(), n, mode);
+		MINES_COUNT(RenderBytes, glyph_bytes);
+		line += '\n';
+		os.write(line.data(), line.size());
+	}
+}
+
+// the column labels
+void write_header(std::ostream& os, int64_t left, int64_t cols, std::pmr::memory_resource* scratch) {
+	std::pmr::string header("   ", scratch);
+	for (int64_t c = 0; c < cols; c++) {
+		append_number(header, left + c, " ");
+	}
+	header += '\n';
+	os.write(header.data(), header.size());
+}
+
+}
+
+void render(std::ostream& os, const Game& game, RenderMode mode, std::pmr::memory_resource* scratch) {
+	write_header(os, 0, game.grid.cols(), scratch);
+
+	with_topology(game.topology, [&](auto topo) {
+		using Topo = decltype(topo);
+		if constexpr (Topo::kind == Topology::Rectangle) {
+			// the counts of every cell at once, from the bitsliced kernel
+			CountPlanes counts(scratch);
+			count_adjacent(bomb_plane(game, scratch), counts);
+			render_rows<Topo>(os, game, mode, [&counts](size_t i, size_t j) {
+				return counts.count(i, j);
+			}, scratch);
+		} else {
+			render_rows<Topo>(os, game, mode, [&game](size_t i, size_t j) {
+				return count_bomb_neighbors<Topo>(game.grid, i, j);
+			}, scratch);
+		}
+	});
+}
+
+void render(std::ostream& os, const EndlessGame& game, const Viewport& view, RenderMode mode, std::pmr::memory_resource* scratch) {
+	write_header(os, view.left, view.cols, scratch);
+
+	bool over = game.state == GameState::OVER;
+	std::pmr::vector<uint8_t> codes(view.cols, scratch);
+	std::pmr::string line(scratch);
+	line.reserve(24 + 16 * codes.size() + 16);
+	for (int r = 0; r < view.rows; r++) {
+		int i = view.top + r;
+		for (int c = 0; c < view.cols; c++) {
+			int j = view.left + c;
+			if (game.is_flagged(i, j)) {
+				codes[c] = Flag;
+			} else if (!over && !game.is_revealed(i, j)) {
+				codes[c] = Hidden;
+			} else {
+				codes[c] = game.is_bomb(i, j) ? static_cast<uint8_t>(Bomb) : static_cast<uint8_t>(count_bomb_neighbors(game, i, j));
+			}
+		}
+
+		line.clear();
+		append_number(line, i, "  ");
+		[[maybe_unused]] size_t glyph_bytes = append_glyphs(line, codes.data(), codes.size(), mode);
+		MINES_COUNT(RenderBytes, glyph_bytes);
+		line += '\n';
+		os.write(line.data(), line.size());
+	}
+}
+
+const char* render_kernel() {
+	return has_ssse3() ? "ssse3" : "scalar";
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory_resource>
+#include <ostream>
+
+#include "endless.hpp"
+#include "game.hpp"
+
+enum class RenderMode {
+	// the board as plain characters, for dumps to files
+	Ascii,
+	// the coloured board of operator<<
+	Ansi,
+};
+
+// renders the whole board a row at a time: each cell is reduced to a code byte, and a row of
+// codes is turned into glyphs by a table lookup, sixteen cells per pshufb in ascii mode and
+// one fixed 16-byte escape slot per cell in ansi mode. ansi mode is the coloured board of
+// operator<<, ascii output is the same layout without the escapes. the rows, codes and count
+// planes are built in scratch, which a caller drawing every frame can point at a reused buffer
+void render(std::ostream& os, const Game& game, RenderMode mode, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+// the rows x cols window of an endless board whose corner is (top, left)
+struct Viewport {
+	int top;
+	int left;
+	int rows;
+	int cols;
+};
+
+// renders the window view of an endless board with the same glyphs, rows and columns labelled
+// with their board coordinates. nothing outside the explored chunks is materialized
+void render(std::ostream& os, const EndlessGame& game, const Viewport& view, RenderMode mode,
+	std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+// "ssse3" or "scalar", whichever the ascii glyph lookup dispatches to on this cpu
+const char* render_kernel();
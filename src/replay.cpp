@@ -0,0 +1,87 @@
+#include "replay.hpp"
+
+#include <ctime>
+#include <new>
+
+uint64_t hash_state(const Game& game) {
+	uint64_t hash = 0xcbf29ce484222325ull;
+	auto feed = [&hash](uint64_t value) {
+		hash = (hash ^ value) * 0x100000001b3ull;
+	};
+
+	for (size_t i = 0; i < game.grid.rows(); i++) {
+		for (size_t j = 0; j < game.grid.cols(); j++) {
+			auto& cell = game.grid.at(i, j);
+			feed(static_cast<uint64_t>(cell.type) | cell.is_flagged(game.epoch) << 2 | cell.is_revealed(game.epoch) << 3);
+		}
+	}
+
+	feed(game.count_bombs);
+	feed(game.count_flagged);
+	feed(game.count_revealed);
+	return hash;
+}
+
+bool read_word(std::istream& is, uint64_t& value, int bytes) {
+	value = 0;
+	for (int b = 0; b < bytes; b++) {
+		int byte = is.get();
+		if (byte == EOF) {
+			return false;
+		}
+
+		value |= static_cast<uint64_t>(byte) << (8 * b);
+	}
+
+	return true;
+}
+
+ReplayResult replay(const std::string& path) {
+	ReplayResult result;
+	std::ifstream is(path, std::ios::binary);
+	char magic[sizeof(replay_magic)];
+	uint32_t m, n, budget, topology;
+	uint64_t seed, likelihood_bits;
+	if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, replay_magic, sizeof(magic)) != 0
+		|| !read_varint(is, m) || !read_varint(is, n) || !read_word(is, seed, 8) || !read_word(is, likelihood_bits, 4)
+		|| !read_varint(is, budget) || !read_varint(is, topology)
+		|| !m || !n || static_cast<uint64_t>(m) * n > Game::max_cells
+		|| topology >= topology_names.size() || !fits(static_cast<Topology>(topology), m, n)) {
+		return result;
+	}
+
+	float likelihood;
+	uint32_t bits = likelihood_bits;
+	std::memcpy(&likelihood, &bits, sizeof(likelihood));
+
+	// a board within max_cells can still be more than the machine has
+	try {
+		Game game(m, n, likelihood, seed);
+		game.set_topology(static_cast<Topology>(topology));
+		Journal journal(budget);
+		if (budget) {
+			game.journal = &journal;
+		}
+
+		Opcode op = Opcode::End;
+		std::pair<int, int> place;
+		auto start = std::clock();
+		while (decode_move(is, op, place) && op != Opcode::End) {
+			apply_move(game, op, place);
+			result.moves++;
+		}
+
+		result.seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+		uint64_t expected;
+		if (op != Opcode::End || !read_word(is, expected, 8)) {
+			return result;
+		}
+
+		result.complete = true;
+		result.matched = expected == hash_state(game);
+	} catch (const std::bad_alloc&) {
+		return ReplayResult();
+	}
+
+	return result;
+}
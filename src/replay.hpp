@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <utility>
+
+#include "game.hpp"
+#include "journal.hpp"
+#include "protocol.hpp"
+
+// fnv-1a over the cell states and counters, used to check replays
+uint64_t hash_state(const Game& game);
+
+// replay log: magic, rows and cols as varints, the seed and likelihood as little-endian words,
+// the undo journal budget as a varint (0 without a journal) and the topology as a varint,
+// then one move frame per move, terminated by an End frame and the hash of the final state.
+constexpr char replay_magic[4] = {'M', 'N', 'R', 'P'};
+
+inline void write_word(std::string& out, uint64_t value, int bytes) {
+	for (int b = 0; b < bytes; b++) {
+		out.push_back(static_cast<char>(value >> (8 * b)));
+	}
+}
+
+bool read_word(std::istream& is, uint64_t& value, int bytes);
+
+struct ReplayWriter {
+	static constexpr size_t buffer_limit = 1 << 16;
+
+	std::ofstream out;
+	std::string buffer;
+
+	ReplayWriter(const std::string& path, const Game& game)
+		: out(path, std::ios::binary | std::ios::trunc)
+	{
+		uint32_t likelihood;
+		std::memcpy(&likelihood, &game.bomb_likelihood, sizeof(likelihood));
+
+		buffer.append(replay_magic, sizeof(replay_magic));
+		write_varint(buffer, game.grid.rows());
+		write_varint(buffer, game.grid.cols());
+		write_word(buffer, game.seed, 8);
+		write_word(buffer, likelihood, 4);
+		write_varint(buffer, game.journal ? game.journal->budget : 0);
+		write_varint(buffer, static_cast<uint32_t>(game.topology));
+	}
+
+	~ReplayWriter() {
+		flush();
+	}
+
+	void record(Opcode op, const std::pair<int, int>& place) {
+		encode_move(buffer, op, place);
+		if (buffer.size() >= buffer_limit) {
+			flush();
+		}
+	}
+
+	void finish(const Game& game) {
+		encode_move(buffer, Opcode::End, {0, 0});
+		write_word(buffer, hash_state(game), 8);
+		flush();
+	}
+
+	void flush() {
+		out.write(buffer.data(), buffer.size());
+		out.flush();
+		buffer.clear();
+	}
+};
+
+
+struct ReplayResult {
+	bool complete = false;
+	bool matched = false;
+	size_t moves = 0;
+	double seconds = 0;
+};
+
+// re-executes a replay log headlessly and checks the final state against the recorded hash
+ReplayResult replay(const std::string& path);
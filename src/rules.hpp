@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "game.hpp"
+#include "protocol.hpp"
+
+// the move rules, written once for every engine. an engine G supplies its storage primitives as
+// members
+//   outside(i, j), is_bomb(i, j), is_flagged(i, j), is_revealed(i, j),
+//   set_bomb(i, j, value), set_flagged(i, j, value), set_revealed(i, j),
+//   clear_last_revealed(), add_last_revealed(i, j), restart(), first_move and state
+// and as free functions
+//   count_bomb_neighbors(game, i, j), count_flagged_neighbors(game, i, j),
+//   for_each_adjacent(game, i, j, f), expand(game, i, j) and is_won(game)
+// an engine whose expand is the cascade below also supplies for_each_spread(game, i, j, f), and
+// the members count_last_revealed(), cascade_stack() and cut_cascade(pending, revealed)
+namespace rules {
+
+// reveals (i, j) and keeps spreading from every revealed cell that has as many flags as bombs
+// around it. the cells wait on an explicit stack, an empty one from cascade_stack() with
+// push_back, pop_back, back, empty and size, so that cascades over huge boards cannot overflow the
+// call stack. before each step cut_cascade(pending, revealed) may finish the cascade another way
+// or stop it early, and returns whether it did
+template <typename G>
+void cascade(G& game, int i, int j) {
+	// reveals (a, b) and returns whether the cascade continues through it
+	auto visit = [&game](int a, int b) {
+		MINES_COUNT(ExpandVisits, 1);
+		if (game.is_bomb(a, b) || game.is_revealed(a, b) || game.is_flagged(a, b)) {
+			return false;
+		}
+
+		game.set_revealed(a, b);
+		game.add_last_revealed(a, b);
+		MINES_COUNT(RevealedCells, 1);
+		return count_flagged_neighbors(game, a, b) == count_bomb_neighbors(game, a, b);
+	};
+
+	size_t revealed_before = game.count_last_revealed();
+	if (game.outside(i, j) || !visit(i, j)) {
+		return;
+	}
+
+	auto pending = game.cascade_stack();
+	pending.push_back({i, j});
+	while (!pending.empty() && !game.cut_cascade(pending, game.count_last_revealed() - revealed_before)) {
+		auto [a, b] = pending.back();
+		pending.pop_back();
+
+		for_each_spread(game, a, b, [&](int c, int d) {
+			if (visit(c, d)) {
+				pending.push_back({c, d});
+			}
+		});
+	}
+
+	MINES_COUNT(Cascades, 1);
+	MINES_RECORD(CascadeSize, game.count_last_revealed() - revealed_before);
+}
+
+template <typename G>
+PlayerMove try_reveal(G& game, const std::pair<int, int>& place) {
+	auto [i, j] = place;
+	game.clear_last_revealed();
+	if (game.outside(i, j)) {
+		return PlayerMove::OutBounds;
+	}
+
+	if (game.is_flagged(i, j)) {
+		return PlayerMove::NA;
+	}
+
+	if (game.is_bomb(i, j)) {
+		game.set_revealed(i, j);
+		game.add_last_revealed(i, j);
+		return PlayerMove::LosingMove;
+	}
+
+	if (!game.is_revealed(i, j)) {
+		expand(game, i, j);
+		return PlayerMove::Success;
+	}
+
+	// expanding on an already revealed cell
+	if (count_flagged_neighbors(game, i, j) != count_bomb_neighbors(game, i, j)) {
+		return PlayerMove::Success;
+	}
+
+	for_each_adjacent(game, i, j, [&game](int a, int b) {
+		expand(game, a, b);
+	});
+
+	return PlayerMove::Success;
+}
+
+template <typename G>
+PlayerMove try_set_flag(G& game, const std::pair<int, int>& place, bool value) {
+	auto [i, j] = place;
+	if (game.outside(i, j)) {
+		return PlayerMove::OutBounds;
+	}
+
+	if (game.is_revealed(i, j)) {
+		return PlayerMove::NA;
+	}
+
+	game.set_flagged(i, j, value);
+	return PlayerMove::Success;
+}
+
+// the first reveal of a game is never a bomb
+template <typename G>
+PlayerMove play_reveal(G& game, const std::pair<int, int>& place) {
+	auto [i, j] = place;
+	if (game.first_move && !game.outside(i, j)) {
+		game.set_bomb(i, j, false);
+		game.first_move = false;
+	}
+
+	// unqualified, so that an engine's own try_reveal wrapping the rule is the one called
+	PlayerMove result = try_reveal(game, place);
+	if (result == PlayerMove::LosingMove) {
+		game.state = GameState::OVER;
+	}
+
+	return result;
+}
+
+// plays op on the board alone. Undo, Redo and anything else without a rule here are NA: only an
+// engine with a recorder or a journal has moves to take back, and it wraps this (Game does, in
+// play_move). the other engines forward to this as it is
+template <typename G>
+PlayerMove apply_move(G& game, Opcode op, const std::pair<int, int>& place) {
+	PlayerMove result;
+	switch (op) {
+		case Opcode::Reveal:
+		case Opcode::Chord:
+			result = rules::play_reveal(game, place);
+			break;
+		case Opcode::Flag:
+		case Opcode::Unflag:
+			game.clear_last_revealed();
+			result = rules::try_set_flag(game, place, op == Opcode::Flag);
+			break;
+		case Opcode::Restart:
+			game.clear_last_revealed();
+			game.restart();
+			return PlayerMove::Success;
+		default:
+			game.clear_last_revealed();
+			return PlayerMove::NA;
+	}
+
+	if (is_won(game)) {
+		game.state = GameState::OVER;
+	}
+
+	return result;
+}
+
+}
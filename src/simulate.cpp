@@ -0,0 +1,190 @@
+#include "simulate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <ostream>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+
+#include "command.hpp"
+#include "console.hpp"
+#include "render.hpp"
+
+namespace {
+
+// chords around every number whose flags are all placed, and flags the hidden neighbours
+// of every number that has exactly as many of them as it has bombs left
+template <typename Topo>
+void plan_moves(const Game& game, std::pmr::vector<std::pair<Opcode, std::pair<int, int>>>& planned, std::pmr::vector<bool>& flagging) {
+	int m = game.grid.rows();
+	int n = game.grid.cols();
+
+	flagging.assign(m * n, false);
+	for (int i = 0; i < m; i++) {
+		for (int j = 0; j < n; j++) {
+			auto& cell = game.grid.at(i, j);
+			if (!cell.is_revealed(game.epoch) || cell.type == CellType::BOMB) {
+				continue;
+			}
+
+			uint32_t bombs = count_bomb_neighbors<Topo>(game.grid, i, j);
+			uint32_t flagged = count_flagged_neighbors<Topo>(game.grid, i, j, game.epoch);
+			uint32_t hidden = count_neighbors<Topo>(game.grid, i, j, [&game](Cell cell) {
+				return !cell.is_revealed(game.epoch) && !cell.is_flagged(game.epoch);
+			});
+
+			if (!hidden) {
+				continue;
+			}
+
+			if (flagged == bombs) {
+				planned.push_back({Opcode::Chord, {i, j}});
+			} else if (bombs - flagged == hidden) {
+				Topo::for_each_adjacent(m, n, i, j, [&](int a, int b) {
+					if (!game.is_revealed(a, b) && !game.is_flagged(a, b) && !flagging[a * n + b]) {
+						flagging[a * n + b] = true;
+						planned.push_back({Opcode::Flag, {a, b}});
+					}
+				});
+			}
+		}
+	}
+}
+
+// a stream buffer over a fixed array that starts over when it fills: the frames are drawn for
+// what drawing them costs, nothing reads them back
+class FrameBuffer : public std::streambuf {
+public:
+	FrameBuffer() {
+		rewind();
+	}
+
+protected:
+	int_type overflow(int_type c) override {
+		rewind();
+		if (!traits_type::eq_int_type(c, traits_type::eof())) {
+			sputc(traits_type::to_char_type(c));
+		}
+
+		return traits_type::not_eof(c);
+	}
+
+private:
+	std::array<char, 1 << 14> bytes;
+
+	void rewind() {
+		setp(bytes.data(), bytes.data() + bytes.size());
+	}
+};
+
+// the words of a move, as the player would type them
+std::string_view move_text(Opcode op, std::pair<int, int> place, std::array<char, 32>& text) {
+	std::string_view word = op == Opcode::Flag ? "flag " : "reveal ";
+	char* end = std::copy(word.begin(), word.end(), text.data());
+	// room is left for the separator and the second number whatever the first is
+	end = std::to_chars(end, text.data() + text.size() - 12, place.first).ptr;
+	*end++ = ' ';
+	end = std::to_chars(end, text.data() + text.size(), place.second).ptr;
+	return std::string_view(text.data(), end - text.data());
+}
+
+}
+
+std::pair<Opcode, std::pair<int, int>> Bot::next_move(const Game& game) {
+	int m = game.grid.rows();
+	int n = game.grid.cols();
+
+	if (game.first_move) {
+		planned.clear();
+		return {Opcode::Reveal, {m / 2, n / 2}};
+	}
+
+	if (planned.empty()) {
+		with_topology(game.topology, [&](auto topo) {
+			plan_moves<decltype(topo)>(game, planned, flagging);
+		});
+	}
+
+	if (!planned.empty()) {
+		auto move = planned.back();
+		planned.pop_back();
+		return move;
+	}
+
+	// nothing is decided, guess: random probes first, then the first hidden cell
+	for (int tries = 0; tries < 64; tries++) {
+		rng = mix64(rng);
+		int k = rng % (m * n);
+		if (!game.is_revealed(k / n, k % n) && !game.is_flagged(k / n, k % n)) {
+			return {Opcode::Reveal, {k / n, k % n}};
+		}
+	}
+
+	for (int k = 0; k < m * n; k++) {
+		if (!game.is_revealed(k / n, k % n) && !game.is_flagged(k / n, k % n)) {
+			return {Opcode::Reveal, {k / n, k % n}};
+		}
+	}
+
+	return {Opcode::Reveal, {0, 0}};
+}
+
+SimulateResult simulate_preset(const Preset& preset, uint64_t games, uint64_t seed, Topology topology) {
+	SimulateResult result;
+	bool render_frames = preset.m * preset.n <= 1024;
+
+	// every game is carved out of one arena and dropped with a single release when it ends. the
+	// backing holds a whole game of the preset, its cells, reveals, cascade stack and the bot's
+	// plans, so that past setting up the arenas a call mallocs nothing
+	std::vector<std::byte> backing(preset.m * preset.n * 16 + (1 << 16));
+	std::pmr::monotonic_buffer_resource arena(backing.data(), backing.size());
+
+	// a frame's rows, codes and count planes, dropped after every frame
+	std::vector<std::byte> frame_backing(render_frames ? 1 << 16 : 0);
+	FrameBuffer frame_bytes;
+	std::ostream frame(&frame_bytes);
+
+	for (uint64_t g = 0; g < games; g++, arena.release()) {
+		Game game(preset.m, preset.n, preset.bomb_likelihood, seed + g, Layout::RowMajor, &arena);
+		game.set_topology(topology);
+		Bot bot(seed + g, &arena);
+		while (game.state != GameState::OVER) {
+			auto [op, place] = bot.next_move(game);
+			// a move's words live in a scratch buffer that is gone with the move
+			std::array<std::byte, 256> scratch;
+			std::pmr::monotonic_buffer_resource line(scratch.data(), scratch.size(), &arena);
+			Command command(&line);
+			{
+				MINES_TRACE_SCOPE(Parse);
+				std::array<char, 32> text;
+				command = to_command(move_text(op, place, text), &line);
+			}
+
+			bool accepted_input;
+			{
+				MINES_TIME_COMMAND();
+				MINES_TRACE_SCOPE(Dispatch);
+				accepted_input = command_table.find(std::string_view(command.front()))->second(game, command);
+			}
+			result.moves++;
+
+			{
+				MINES_TRACE_SCOPE(WinCheck);
+				if (is_won(game)) {
+					game.state = GameState::OVER;
+					result.wins++;
+				}
+			}
+
+			if (accepted_input && render_frames) {
+				MINES_TRACE_SCOPE(Render);
+				std::pmr::monotonic_buffer_resource frame_scratch(frame_backing.data(), frame_backing.size());
+				render(frame, game, RenderMode::Ansi, &frame_scratch);
+			}
+		}
+	}
+
+	return result;
+}
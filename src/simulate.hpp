@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "game.hpp"
+#include "protocol.hpp"
+
+// a simple auto-player for headless runs: it flags and chords around numbers whose
+// neighbourhood is decided, and guesses a random hidden cell when nothing is
+struct Bot {
+	uint64_t rng;
+	std::pmr::vector<std::pair<Opcode, std::pair<int, int>>> planned;
+	// the cells a plan already flags, kept between plans so that planning allocates nothing
+	std::pmr::vector<bool> flagging;
+
+	explicit Bot(uint64_t seed, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: rng(seed), planned(resource), flagging(resource) {}
+
+	std::pair<Opcode, std::pair<int, int>> next_move(const Game& game);
+};
+
+// the boards --simulate plays, and how many times fewer games each plays
+struct Preset {
+	const char* name;
+	size_t m;
+	size_t n;
+	float bomb_likelihood;
+	uint64_t games_divisor;
+};
+
+inline constexpr Preset presets[] = {
+	{"beginner", 9, 9, .12f, 1},
+	{"intermediate", 16, 16, .15f, 1},
+	{"expert", 16, 30, .2f, 1},
+	{"huge", 256, 256, .15f, 50},
+};
+
+struct SimulateResult {
+	uint64_t wins = 0;
+	uint64_t moves = 0;
+};
+
+// headless auto-play of games boards of preset, seeded from seed on: the bot's moves go through
+// the same command table as typed input, and the board is rendered after every move on all but
+// the huge preset. every game, move and frame is carved out of arenas set up once per call,
+// only the workers of a parallel flood allocate on their own
+SimulateResult simulate_preset(const Preset& preset, uint64_t games, uint64_t seed, Topology topology);
@@ -0,0 +1,63 @@
+#include "snapshot.hpp"
+
+#include <fstream>
+#include <vector>
+
+bool save_snapshot(const Game& game, const std::string& path) {
+	size_t m = game.grid.rows();
+	size_t n = game.grid.cols();
+
+	SnapshotHeader header{};
+	std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+	header.rows = m;
+	header.cols = n;
+	header.bomb_likelihood = game.bomb_likelihood;
+	header.seed = game.seed;
+	header.count_bombs = game.count_bombs;
+	header.count_flagged = game.count_flagged;
+	header.count_revealed = game.count_revealed;
+	header.first_move = game.first_move;
+	header.state = static_cast<uint8_t>(game.state);
+	header.topology = static_cast<uint8_t>(game.topology);
+	header.words_per_plane = (m * n + 63) / 64;
+
+	std::vector<uint64_t> planes(3 * header.words_per_plane);
+	uint64_t* bombs = planes.data();
+	uint64_t* flags = bombs + header.words_per_plane;
+	uint64_t* revealed = flags + header.words_per_plane;
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			auto& cell = game.grid.at(i, j);
+			size_t k = i * n + j;
+			bombs[k / 64] |= static_cast<uint64_t>(cell.type == CellType::BOMB) << (k % 64);
+			flags[k / 64] |= static_cast<uint64_t>(cell.is_flagged(game.epoch)) << (k % 64);
+			revealed[k / 64] |= static_cast<uint64_t>(cell.is_revealed(game.epoch)) << (k % 64);
+		}
+	}
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(planes.data()), planes.size() * sizeof(uint64_t));
+	return static_cast<bool>(out);
+}
+
+Game load_snapshot(const SnapshotView& view, Layout layout) {
+	const SnapshotHeader& header = *view.header;
+	Game game(0, 0, header.bomb_likelihood, header.seed);
+	game.grid.assign(header.rows, header.cols, layout);
+	for (size_t i = 0; i < header.rows; i++) {
+		for (size_t j = 0; j < header.cols; j++) {
+			size_t k = i * header.cols + j;
+			game.set_bomb(i, j, test_bit(view.bombs, k));
+			game.set_flagged(i, j, test_bit(view.flags, k));
+			if (test_bit(view.revealed, k)) {
+				game.set_revealed(i, j);
+			}
+		}
+	}
+
+	game.first_move = header.first_move;
+	game.state = static_cast<GameState>(header.state);
+	game.set_topology(static_cast<Topology>(header.topology));
+	return game;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "game.hpp"
+#include "mapped_file.hpp"
+
+// snapshot: a fixed header followed by three bit-packed planes (bombs, flags, revealed)
+// of words_per_plane words each, bit k being the cell at row-major index k.
+constexpr char snapshot_magic[4] = {'M', 'N', 'S', 'N'};
+
+struct SnapshotHeader {
+	char magic[4];
+	uint32_t rows;
+	uint32_t cols;
+	float bomb_likelihood;
+	uint64_t seed;
+	uint32_t count_bombs;
+	uint32_t count_flagged;
+	uint32_t count_revealed;
+	uint8_t first_move;
+	uint8_t state;
+	uint8_t topology;
+	uint8_t reserved;
+	uint64_t words_per_plane;
+};
+
+static_assert(sizeof(SnapshotHeader) % sizeof(uint64_t) == 0, "planes must stay word aligned");
+
+inline bool test_bit(const uint64_t* plane, size_t index) {
+	return plane[index / 64] >> (index % 64) & 1;
+}
+
+bool save_snapshot(const Game& game, const std::string& path);
+
+// read-only mapping of a snapshot file, the planes point straight into the mapping
+struct SnapshotView {
+	MappedFile file;
+	const SnapshotHeader* header = nullptr;
+	const uint64_t* bombs = nullptr;
+	const uint64_t* flags = nullptr;
+	const uint64_t* revealed = nullptr;
+
+	bool open(const std::string& path) {
+		if (!file.open(path, sizeof(SnapshotHeader))) {
+			return false;
+		}
+
+		header = static_cast<const SnapshotHeader*>(file.data);
+		if (std::memcmp(header->magic, snapshot_magic, sizeof(snapshot_magic)) != 0
+			|| !header->rows || !header->cols || static_cast<uint64_t>(header->rows) * header->cols > Game::max_cells
+			|| header->topology >= topology_names.size() || !fits(static_cast<Topology>(header->topology), header->rows, header->cols)
+			|| header->state > static_cast<uint8_t>(GameState::ACTIVE) || header->first_move > 1
+			|| header->words_per_plane != (static_cast<uint64_t>(header->rows) * header->cols + 63) / 64
+			|| file.size < sizeof(SnapshotHeader) + 3 * header->words_per_plane * sizeof(uint64_t)) {
+			return false;
+		}
+
+		bombs = reinterpret_cast<const uint64_t*>(header + 1);
+		flags = bombs + header->words_per_plane;
+		revealed = flags + header->words_per_plane;
+		return true;
+	}
+};
+
+Game load_snapshot(const SnapshotView& view, Layout layout = Layout::RowMajor);
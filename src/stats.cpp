@@ -0,0 +1,85 @@
+#include "stats.hpp"
+
+#ifdef MINES_STATS
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace stats {
+
+namespace {
+
+std::mutex registry_mutex;
+std::vector<ThreadSlots*> live;
+Totals retired;
+
+void accumulate(Totals& totals, const ThreadSlots& slots) {
+	for (int c = 0; c < counter_count; c++) {
+		totals.counters[c] += slots.counters[c].load(std::memory_order_relaxed);
+	}
+
+	for (int h = 0; h < histogram_count; h++) {
+		for (int b = 0; b < bucket_count; b++) {
+			totals.histograms[h][b] += slots.histograms[h][b].load(std::memory_order_relaxed);
+		}
+	}
+}
+
+const char* counter_names[counter_count] = {
+	"expand_visits",
+	"neighbor_scans",
+	"cascades",
+	"revealed_cells",
+	"render_bytes",
+	"commands",
+	"chunks_materialized",
+};
+
+const char* histogram_names[histogram_count] = {
+	"cascade_size",
+	"command_latency_ns",
+};
+
+}
+
+ThreadSlots::ThreadSlots() {
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	live.push_back(this);
+}
+
+ThreadSlots::~ThreadSlots() {
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	accumulate(retired, *this);
+	live.erase(std::find(live.begin(), live.end(), this));
+}
+
+Totals collect() {
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	Totals totals = retired;
+	for (auto slots : live) {
+		accumulate(totals, *slots);
+	}
+
+	return totals;
+}
+
+void report(std::ostream& os) {
+	Totals totals = collect();
+	for (int c = 0; c < counter_count; c++) {
+		os << counter_names[c] << ": " << totals.counters[c] << '\n';
+	}
+
+	for (int h = 0; h < histogram_count; h++) {
+		os << histogram_names[h] << ":\n";
+		for (int b = 0; b < bucket_count; b++) {
+			if (totals.histograms[h][b]) {
+				os << "  < " << (1ull << b) << ": " << totals.histograms[h][b] << '\n';
+			}
+		}
+	}
+}
+
+}
+
+#endif
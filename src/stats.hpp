@@ -0,0 +1,96 @@
+#pragma once
+
+// engine counters and histograms, compiled in only when MINES_STATS is defined. every thread
+// writes its own slots, collect() sums the slots of all threads that ever recorded anything.
+#ifdef MINES_STATS
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace stats {
+
+enum Counter {
+	ExpandVisits,
+	NeighborScans,
+	Cascades,
+	RevealedCells,
+	RenderBytes,
+	Commands,
+	ChunksMaterialized,
+	counter_count,
+};
+
+enum Histogram {
+	CascadeSize,
+	CommandLatencyNs,
+	histogram_count,
+};
+
+// bucket k holds values in [2^(k-1), 2^k), bucket 0 holds zero
+constexpr int bucket_count = 40;
+
+struct Totals {
+	std::array<uint64_t, counter_count> counters{};
+	std::array<std::array<uint64_t, bucket_count>, histogram_count> histograms{};
+};
+
+struct ThreadSlots {
+	std::array<std::atomic<uint64_t>, counter_count> counters{};
+	std::array<std::array<std::atomic<uint64_t>, bucket_count>, histogram_count> histograms{};
+
+	ThreadSlots();
+	~ThreadSlots();
+};
+
+inline ThreadSlots& local() {
+	thread_local ThreadSlots slots;
+	return slots;
+}
+
+// only the owning thread writes a slot, so a relaxed load and store is enough
+inline void bump(std::atomic<uint64_t>& slot, uint64_t n) {
+	slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void add(Counter counter, uint64_t n) {
+	bump(local().counters[counter], n);
+}
+
+inline void record(Histogram histogram, uint64_t value) {
+	int bucket = 0;
+	while (value && bucket < bucket_count - 1) {
+		value >>= 1;
+		bucket++;
+	}
+	bump(local().histograms[histogram][bucket], 1);
+}
+
+Totals collect();
+void report(std::ostream& os);
+
+struct ScopedLatency {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	~ScopedLatency() {
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		add(Commands, 1);
+		record(CommandLatencyNs, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+	}
+};
+
+}
+
+#define MINES_COUNT(counter, n) stats::add(stats::counter, (n))
+#define MINES_RECORD(histogram, value) stats::record(stats::histogram, (value))
+#define MINES_TIME_COMMAND() stats::ScopedLatency mines_command_latency
+
+#else
+
+#define MINES_COUNT(counter, n) ((void)0)
+#define MINES_RECORD(histogram, value) ((void)0)
+#define MINES_TIME_COMMAND() ((void)0)
+
+#endif
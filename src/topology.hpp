@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// neighbour offsets as {row, column} deltas
+inline constexpr std::array<std::array<int, 2>, 4> dir4{{{0, 1}, {1, 0}, {0, -1}, {-1, 0}}};
+inline constexpr std::array<std::array<int, 2>, 8> dir8{{{0, 1}, {1, 0}, {0, -1}, {-1, 0}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+// hex boards in odd-r offset coordinates: odd rows sit half a cell to the right,
+// so the diagonal neighbours depend on the parity of the row
+inline constexpr std::array<std::array<int, 2>, 6> hex_even{{{0, 1}, {0, -1}, {-1, -1}, {-1, 0}, {1, -1}, {1, 0}}};
+inline constexpr std::array<std::array<int, 2>, 6> hex_odd{{{0, 1}, {0, -1}, {-1, 0}, {-1, 1}, {1, 0}, {1, 1}}};
+
+template <const auto& dirs, typename F, size_t... k>
+constexpr void for_each_offset(int i, int j, F& f, std::index_sequence<k...>) {
+	(f(i + dirs[k][0], j + dirs[k][1]), ...);
+}
+
+// calls f(a, b) for each neighbour of (i, j) under dirs, unrolled at compile time.
+// the neighbours are not bounds checked
+template <const auto& dirs, typename F>
+constexpr void for_each_neighbor(int i, int j, F&& f) {
+	for_each_offset<dirs>(i, j, f, std::make_index_sequence<dirs.size()>{});
+}
+
+enum class Topology : uint8_t {
+	Rectangle = 0,
+	Torus = 1,
+	Hex = 2,
+};
+
+// names for the command line, indexed by Topology
+inline constexpr std::array<const char*, 3> topology_names{"rectangle", "torus", "hex"};
+
+constexpr bool inside(int m, int n, int i, int j) {
+	return i >= 0 && j >= 0 && i < m && j < n;
+}
+
+// topology policies for an m x n board. for_each_adjacent visits the cells counted by the
+// numbers and opened by a chord, for_each_spread the cells a cascade continues into.
+// both only ever call f with cells on the board.
+struct Rectangle {
+	static constexpr Topology kind = Topology::Rectangle;
+
+	template <typename F>
+	static constexpr void for_each_adjacent(int m, int n, int i, int j, F&& f) {
+		for_each_neighbor<dir8>(i, j, [&](int a, int b) {
+			if (inside(m, n, a, b)) {
+				f(a, b);
+			}
+		});
+	}
+
+	template <typename F>
+	static constexpr void for_each_spread(int m, int n, int i, int j, F&& f) {
+		for_each_neighbor<dir4>(i, j, [&](int a, int b) {
+			if (inside(m, n, a, b)) {
+				f(a, b);
+			}
+		});
+	}
+};
+
+// the edges wrap around, every offset lands on the board and nothing is bounds checked.
+// boards need at least 3 rows and columns, or a cell would see a neighbour twice
+struct Torus {
+	static constexpr Topology kind = Topology::Torus;
+	static constexpr size_t min_size = 3;
+
+	static constexpr int wrap(int a, int size) {
+		return a < 0 ? a + size : (a >= size ? a - size : a);
+	}
+
+	template <typename F>
+	static constexpr void for_each_adjacent(int m, int n, int i, int j, F&& f) {
+		for_each_neighbor<dir8>(i, j, [&](int a, int b) {
+			f(wrap(a, m), wrap(b, n));
+		});
+	}
+
+	template <typename F>
+	static constexpr void for_each_spread(int m, int n, int i, int j, F&& f) {
+		for_each_neighbor<dir4>(i, j, [&](int a, int b) {
+			f(wrap(a, m), wrap(b, n));
+		});
+	}
+};
+
+// six neighbours per cell, and a cascade spreads to all of them
+struct Hex {
+	static constexpr Topology kind = Topology::Hex;
+
+	template <typename F>
+	static constexpr void for_each_adjacent(int m, int n, int i, int j, F&& f) {
+		auto visit = [&](int a, int b) {
+			if (inside(m, n, a, b)) {
+				f(a, b);
+			}
+		};
+
+		if (i & 1) {
+			for_each_neighbor<hex_odd>(i, j, visit);
+		} else {
+			for_each_neighbor<hex_even>(i, j, visit);
+		}
+	}
+
+	template <typename F>
+	static constexpr void for_each_spread(int m, int n, int i, int j, F&& f) {
+		for_each_adjacent(m, n, i, j, f);
+	}
+};
+
+// whether an m x n board can be played under topology, every topology but the torus fits any size
+constexpr bool fits(Topology topology, size_t m, size_t n) {
+	return topology != Topology::Torus || (m >= Torus::min_size && n >= Torus::min_size);
+}
+
+// calls f with the policy for topology. engine entry points dispatch here once per move,
+// everything below them is instantiated per topology
+template <typename F>
+constexpr decltype(auto) with_topology(Topology topology, F&& f) {
+	switch (topology) {
+		case Topology::Torus:
+			return f(Torus{});
+		case Topology::Hex:
+			return f(Hex{});
+		default:
+			return f(Rectangle{});
+	}
+}
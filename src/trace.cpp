@@ -0,0 +1,73 @@
+#include "trace.hpp"
+
+#ifdef MINES_TRACE
+
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+
+std::atomic<bool> enabled{false};
+
+namespace {
+
+// rings outlive their threads so that events of finished threads still get dumped
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<Ring>> rings;
+std::string output_path;
+uint64_t origin_ns;
+
+const char* phase_names[phase_count] = {
+	"parse",
+	"dispatch",
+	"reveal",
+	"win_check",
+	"render",
+};
+
+void dump_at_exit() {
+	std::ofstream os(output_path);
+	dump(os);
+}
+
+}
+
+Ring& local() {
+	thread_local Ring* ring = [] {
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		rings.push_back(std::make_unique<Ring>());
+		rings.back()->tid = rings.size();
+		return rings.back().get();
+	}();
+	return *ring;
+}
+
+void start(const std::string& path) {
+	output_path = path;
+	origin_ns = now_ns();
+	enabled.store(true, std::memory_order_relaxed);
+	std::atexit(dump_at_exit);
+}
+
+void dump(std::ostream& os) {
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	os << "{\"traceEvents\": [";
+	bool first = true;
+	for (auto& ring : rings) {
+		uint64_t head = ring->head.load(std::memory_order_acquire);
+		for (uint64_t k = (head > ring_size ? head - ring_size : 0); k < head; k++) {
+			const Event& event = ring->events[k % ring_size];
+			os << (first ? "\n" : ",\n") << "{\"name\": \"" << phase_names[event.phase] << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << ring->tid
+				<< ", \"ts\": " << (event.begin_ns - origin_ns) / 1000.0
+				<< ", \"dur\": " << (event.end_ns - event.begin_ns) / 1000.0 << "}";
+			first = false;
+		}
+	}
+	os << "\n]}\n";
+}
+
+}
+
+#endif
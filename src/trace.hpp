@@ -0,0 +1,84 @@
+#pragma once
+
+// turn-phase tracing, compiled in only when MINES_TRACE is defined. every thread appends
+// complete events to its own ring buffer, the newest ring_size of them are kept, and all
+// rings are written as chrome trace json (chrome://tracing, perfetto) when the process exits.
+#ifdef MINES_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace trace {
+
+enum Phase : uint8_t {
+	Parse,
+	Dispatch,
+	Reveal,
+	WinCheck,
+	Render,
+	phase_count,
+};
+
+struct Event {
+	uint64_t begin_ns;
+	uint64_t end_ns;
+	Phase phase;
+};
+
+constexpr size_t ring_size = 1 << 16;
+
+// written only by its thread, head is published with release so a dump sees whole events
+struct Ring {
+	std::unique_ptr<Event[]> events{new Event[ring_size]};
+	std::atomic<uint64_t> head{0};
+	uint32_t tid;
+};
+
+extern std::atomic<bool> enabled;
+
+Ring& local();
+
+inline uint64_t now_ns() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline void emit(Phase phase, uint64_t begin_ns, uint64_t end_ns) {
+	Ring& ring = local();
+	uint64_t head = ring.head.load(std::memory_order_relaxed);
+	ring.events[head % ring_size] = {begin_ns, end_ns, phase};
+	ring.head.store(head + 1, std::memory_order_release);
+}
+
+struct Scope {
+	Phase phase;
+	uint64_t begin_ns;
+
+	explicit Scope(Phase phase)
+		: phase(phase), begin_ns(enabled.load(std::memory_order_relaxed) ? now_ns() : 0) {}
+
+	~Scope() {
+		if (begin_ns) {
+			emit(phase, begin_ns, now_ns());
+		}
+	}
+};
+
+// starts recording and writes the trace to path at exit
+void start(const std::string& path);
+void dump(std::ostream& os);
+
+}
+
+#define MINES_TRACE_CONCAT(a, b) a##b
+#define MINES_TRACE_NAME(line) MINES_TRACE_CONCAT(mines_trace_scope_, line)
+#define MINES_TRACE_SCOPE(phase) trace::Scope MINES_TRACE_NAME(__LINE__)(trace::phase)
+
+#else
+
+#define MINES_TRACE_SCOPE(phase) ((void)0)
+
+#endif
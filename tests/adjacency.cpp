@@ -0,0 +1,43 @@
+#include <cstddef>
+#include <string>
+
+#include "adjacency.hpp"
+#include "game.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+void adjacency() {
+	// widths on either side of the 64-bit word and the 256-bit avx2 step
+	for (size_t n : {1, 2, 63, 64, 65, 255, 256, 257, 300, 513}) {
+		for (size_t m : {1, 3, 17}) {
+			Game game(m, n, .3f, m * 1000 + n);
+			BitPlane plane = bomb_plane(game);
+			CountPlanes dispatched, scalar;
+			count_adjacent(plane, dispatched);
+			count_adjacent_scalar(plane, scalar);
+
+			std::string name = std::to_string(m) + "x" + std::to_string(n);
+			for (int b = 0; b < 4; b++) {
+				expect(dispatched.planes[b].words == scalar.planes[b].words, std::string(adjacency_kernel()) + " plane " + std::to_string(b) + ", " + name);
+			}
+
+			bool counts = true;
+			for (size_t i = 0; i < m; i++) {
+				for (size_t j = 0; j < n; j++) {
+					counts &= scalar.count(i, j) == count_bomb_neighbors(game, i, j);
+				}
+			}
+			expect(counts, "scalar counts, " + name);
+		}
+	}
+}
+
+const Register adjacency_case("adjacency", adjacency);
+
+}
+
+}
@@ -0,0 +1,53 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bitboard.hpp"
+#include "game.hpp"
+#include "protocol.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+void bit_game_matches_game(int m, int n, float bomb_likelihood, uint64_t games) {
+	for (uint64_t seed = 0; seed < games; seed++) {
+		Game game(m, n, bomb_likelihood, seed);
+		BitGame bits(m, n, bomb_likelihood, seed);
+		uint64_t rng = seed;
+		for (int move = 0; move < 300 && game.state != GameState::OVER; move++) {
+			auto [op, place] = random_move(rng, m, n);
+			PlayerMove expected = apply_move(game, op, place);
+			PlayerMove actual = apply_move(bits, op, place);
+
+			std::vector<uint32_t> cells;
+			for (int k = 0; k < m * n; k++) {
+				if (bits.last_revealed >> k & 1) {
+					cells.push_back(k);
+				}
+			}
+			bool same = expected == actual && cells == sorted_revealed(game) && bits.state == game.state
+				&& count_bombs(bits) == game.count_bombs && static_cast<uint32_t>(popcount(bits.flags)) == game.count_flagged
+				&& count_revealed(bits) == game.count_revealed;
+			if (!expect(same, "BitGame " + std::to_string(m) + "x" + std::to_string(n) + ", " + seed_name(seed, move))) {
+				return;
+			}
+		}
+	}
+}
+
+void bit_game() {
+	bit_game_matches_game(9, 9, .12f, 1000);
+	bit_game_matches_game(8, 16, .15f, 1000);
+	bit_game_matches_game(1, 128, .1f, 300);
+	bit_game_matches_game(128, 1, .1f, 300);
+	bit_game_matches_game(11, 11, .3f, 1000);
+}
+
+const Register bit_game_case("bit_game", bit_game);
+
+}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "game.hpp"
+#include "protocol.hpp"
+
+// engine tests: every file registers its cases at static initialization and main runs them in
+// link order, printing a line per case. a case checks one engine or kernel against a simpler one
+// on boards from fixed seeds, and the process fails if any check did
+namespace tests {
+
+struct Case {
+	const char* name;
+	void (*run)();
+};
+
+inline std::vector<Case>& cases() {
+	static std::vector<Case> all;
+	return all;
+}
+
+struct Register {
+	Register(const char* name, void (*run)()) {
+		cases().push_back({name, run});
+	}
+};
+
+inline size_t failures = 0;
+
+// counts and reports a failed check, returns ok so that a case can stop at its first failure
+inline bool expect(bool ok, const std::string& what) {
+	if (!ok) {
+		failures++;
+		std::cout << "  failed: " << what << '\n';
+	}
+
+	return ok;
+}
+
+// a file for a case to write and read back, in the temporary directory
+inline std::string temp_path(const std::string& name) {
+	return (std::filesystem::temp_directory_path() / ("mines_tests_" + name)).string();
+}
+
+inline std::string seed_name(uint64_t seed, int move) {
+	return "seed " + std::to_string(seed) + " move " + std::to_string(move);
+}
+
+// a pseudo-random move within a window one cell larger than the board, so that some are out of bounds
+inline std::pair<Opcode, std::pair<int, int>> random_move(uint64_t& rng, int m, int n) {
+	rng = mix64(rng);
+	uint64_t kind = (rng >> 40) % 16;
+	Opcode op = kind < 3 ? Opcode::Flag : kind < 4 ? Opcode::Unflag : kind < 6 ? Opcode::Chord : Opcode::Reveal;
+	if (kind == 15 && (rng >> 48) % 8 == 0) {
+		op = Opcode::Restart;
+	}
+
+	return {op, {static_cast<int>(rng % (m + 1)), static_cast<int>((rng >> 20) % (n + 1))}};
+}
+
+inline std::vector<uint32_t> sorted_revealed(const Game& game) {
+	std::vector<uint32_t> cells(game.last_revealed.begin(), game.last_revealed.end());
+	std::sort(cells.begin(), cells.end());
+	return cells;
+}
+
+}
@@ -0,0 +1,96 @@
+#include <array>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "command.hpp"
+#include "console.hpp"
+#include "game.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+void splitting() {
+	// the words and the list come from the arena alone
+	std::array<std::byte, 1024> buffer;
+	std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+	Command command = to_command(" \treveal  3 4\n5   6 ", &arena);
+	std::vector<std::string> words(command.begin(), command.end());
+	expect(words == std::vector<std::string>{"reveal", "3", "4", "5", "6"}, "words of a line with mixed whitespace");
+	expect(command.get_allocator().resource() == &arena, "command allocator");
+
+	expect(to_command("", &arena).empty(), "empty line");
+	expect(to_command(" \t \r\n", &arena).empty(), "blank line");
+
+	std::string word(100, 'x');
+	Command longer = to_command("flag " + word, &arena);
+	expect(longer.size() == 2 && std::string_view(longer[1]) == word, "a word longer than the small string buffer");
+}
+
+void places() {
+	std::pmr::vector<std::pair<int, int>> parsed;
+	expect(parse_places(to_command("reveal 3 4"), parsed) == ParseError::None && parsed == std::pmr::vector<std::pair<int, int>>{{3, 4}}, "one place");
+	expect(parse_places(to_command("flag 0 1 2 3 -4 5"), parsed) == ParseError::None
+		&& parsed == std::pmr::vector<std::pair<int, int>>{{0, 1}, {2, 3}, {-4, 5}}, "three places");
+	expect(parse_places(to_command("reveal 2147483647 -2147483648"), parsed) == ParseError::None
+		&& parsed == std::pmr::vector<std::pair<int, int>>{{2147483647, -2147483648}}, "the int limits");
+
+	for (const char* line : {"reveal", "reveal 3", "reveal 3 4 5", "flag 1 2 3 4 5"}) {
+		expect(parse_places(to_command(line), parsed) == ParseError::Arity, std::string("arity of \"") + line + '"');
+	}
+
+	for (const char* line : {"reveal x 4", "reveal 3 4x", "reveal 3 +4", "reveal 0x10 1", "reveal 2147483648 0", "flag 1 2 3 -"}) {
+		expect(parse_places(to_command(line), parsed) == ParseError::NotANumber, std::string("number in \"") + line + '"');
+	}
+}
+
+// runs line through the command table as accept_input does, returning what it printed
+std::string dispatch(Game& game, const std::string& line, bool& redraw) {
+	std::ostringstream printed;
+	std::streambuf* out = std::cout.rdbuf(printed.rdbuf());
+	Command command = to_command(line);
+	auto option = command_table.find(std::string_view(command.front()));
+	redraw = option != command_table.end() && option->second(game, command);
+	std::cout.rdbuf(out);
+	return printed.str();
+}
+
+// a bad command is reported and leaves the board as it was, and the next one plays on
+void recovery() {
+	Game game(9, 9, .12f, 7);
+	bool redraw;
+	for (const char* line : {"reveal", "reveal 3", "flag 3 4 5", "reveal x y", "unflag 1 2z", "save", "dump a b"}) {
+		std::string printed = dispatch(game, line, redraw);
+		expect(!redraw && !printed.empty() && game.first_move && game.count_flagged == 0, std::string("rejected \"") + line + '"');
+	}
+
+	std::string printed = dispatch(game, "reveal 9 0 0 9 -1 3", redraw);
+	expect(redraw && printed.find("[9, 0]") != std::string::npos && printed.find("[-1, 3]") != std::string::npos && game.first_move,
+		"reveals outside the grid");
+
+	dispatch(game, "flag 2 2 3 3", redraw);
+	expect(redraw && game.is_flagged(2, 2) && game.is_flagged(3, 3) && game.count_flagged == 2, "flagging two cells");
+	printed = dispatch(game, "reveal 3 3", redraw);
+	expect(printed.find("flagged cell") != std::string::npos && !game.is_revealed(3, 3), "revealing a flagged cell");
+	dispatch(game, "unflag 3 3", redraw);
+	expect(!game.is_flagged(3, 3) && game.count_flagged == 1, "unflagging a cell");
+
+	dispatch(game, "reveal 4 4", redraw);
+	expect(redraw && !game.first_move && game.is_revealed(4, 4), "revealing a cell");
+}
+
+const Register splitting_case("command_words", splitting);
+const Register places_case("command_places", places);
+const Register recovery_case("command_recovery", recovery);
+
+}
+
+}
@@ -0,0 +1,100 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "corpus.hpp"
+#include "game.hpp"
+#include "metrics.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+// every board of a built corpus loads as the board its seed draws, with its metrics
+void round_trip() {
+	std::string path = temp_path("round_trip.corpus");
+	struct Size {
+		size_t m;
+		size_t n;
+	};
+
+	for (Size size : {Size{9, 9}, Size{1, 64}, Size{16, 30}, Size{7, 65}}) {
+		std::string name = std::to_string(size.m) + "x" + std::to_string(size.n);
+		CorpusView view;
+		if (!expect(build_corpus(path, size.m, size.n, .18f, 100, 40, true) && view.open(path) && view.header->count == 40, "building, " + name)) {
+			continue;
+		}
+
+		for (uint64_t k = 0; k < 40; k++) {
+			Game expected(size.m, size.n, .18f, 100 + k);
+			Game loaded = load_corpus_board(view, k, k % 2 ? Layout::Tiled : Layout::RowMajor);
+			bool same = loaded.seed == expected.seed && loaded.count_bombs == expected.count_bombs && view.board(k).count_bombs == expected.count_bombs;
+			for (size_t i = 0; i < size.m; i++) {
+				for (size_t j = 0; j < size.n; j++) {
+					same &= loaded.is_bomb(i, j) == expected.is_bomb(i, j);
+				}
+			}
+
+			BoardMetrics metrics = compute_metrics(expected);
+			same &= view.board(k).bbbv == metrics.bbbv && view.board(k).openings == metrics.openings && view.board(k).isolated == metrics.isolated;
+			if (!expect(same, "board " + std::to_string(k) + ", " + name)) {
+				break;
+			}
+		}
+	}
+	std::remove(path.c_str());
+}
+
+// a header promising more boards or cells than the file holds is refused
+void bad_files() {
+	std::string path = temp_path("bad.corpus");
+	build_corpus(path, 9, 9, .15f, 1, 10, false);
+	std::string bytes;
+	{
+		std::ifstream in(path, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	CorpusHeader good;
+	std::memcpy(&good, bytes.data(), sizeof(good));
+
+	auto opens = [&](const std::string& file) {
+		std::ofstream(path, std::ios::binary | std::ios::trunc).write(file.data(), file.size());
+		CorpusView view;
+		return view.open(path);
+	};
+
+	auto with = [&](auto change) {
+		CorpusHeader header = good;
+		change(header);
+		std::string file = bytes;
+		std::memcpy(file.data(), &header, sizeof(header));
+		return opens(file);
+	};
+
+	expect(opens(bytes), "the built file");
+	expect(!opens(bytes.substr(0, bytes.size() - 1)), "a file one byte short");
+	expect(!opens(bytes.substr(0, sizeof(CorpusHeader) - 1)), "a file shorter than the header");
+	expect(with([](CorpusHeader& h) { h.count = 9; }), "fewer boards than the file holds");
+	expect(!with([](CorpusHeader& h) { h.count = 11; }), "one board too many");
+	// 2^64 / 40 rounded up: times the 40-byte record it wraps to 24 bytes
+	expect(!with([](CorpusHeader& h) { h.count = 0x0666666666666667; }), "a count whose size wraps");
+	expect(!with([](CorpusHeader& h) { h.count = ~uint64_t(0); }), "the largest count");
+	expect(!with([](CorpusHeader& h) { h.words_per_board = 3; }), "too many words per board");
+	expect(!with([](CorpusHeader& h) { h.cols = 0; }), "no columns");
+	expect(!with([](CorpusHeader& h) { h.rows = h.cols = 0xffffffff; h.words_per_board = (uint64_t(0xffffffff) * 0xffffffff + 63) / 64; }), "too many cells");
+	expect(!with([](CorpusHeader& h) { h.magic[0] = 'X'; }), "a bad magic");
+	std::remove(path.c_str());
+}
+
+const Register round_trip_case("corpus_round_trip", round_trip);
+const Register bad_files_case("corpus_files", bad_files);
+
+}
+
+}
@@ -0,0 +1,164 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "endless.hpp"
+#include "protocol.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+constexpr int int_min = std::numeric_limits<int>::min();
+constexpr int int_max = std::numeric_limits<int>::max();
+
+// the cells a first reveal at (i, j) opens on an unflagged board, from a plain flood over the bombs
+// the seed draws
+std::set<std::pair<int, int>> expected_opening(uint64_t seed, float bomb_likelihood, int i, int j) {
+	auto bomb = [&](int a, int b) {
+		return (a != i || b != j) && is_endless_bomb_at(seed, a, b, bomb_likelihood);
+	};
+	auto zero = [&](int a, int b) {
+		bool none = true;
+		for_each_neighbor<dir8>(a, b, [&](int c, int d) {
+			none &= !bomb(c, d);
+		});
+		return none;
+	};
+
+	std::set<std::pair<int, int>> opened{{i, j}};
+	std::vector<std::pair<int, int>> pending;
+	if (zero(i, j)) {
+		pending.push_back({i, j});
+	}
+	while (!pending.empty()) {
+		auto [a, b] = pending.back();
+		pending.pop_back();
+		for_each_neighbor<dir4>(a, b, [&](int c, int d) {
+			if (!bomb(c, d) && opened.insert({c, d}).second && zero(c, d)) {
+				pending.push_back({c, d});
+			}
+		});
+	}
+
+	return opened;
+}
+
+// the chunks a set of written cells lives in
+std::set<uint64_t> chunks_of(const std::vector<std::pair<int, int>>& cells) {
+	std::set<uint64_t> keys;
+	for (auto [i, j] : cells) {
+		keys.insert(EndlessGame::chunk_key(i, j));
+	}
+
+	return keys;
+}
+
+// openings that cross chunk edges reveal what a plain flood does, and materialize exactly the
+// chunks they wrote to
+void openings() {
+	for (uint64_t seed = 0; seed < 200; seed++) {
+		float bomb_likelihood = .1f + seed % 10 * .02f;
+		// around the origin, where the chunk keys of negative rows and columns begin
+		int i = static_cast<int>(seed * 37 % 200) - 100;
+		int j = static_cast<int>(seed * 53 % 200) - 100;
+		EndlessGame game(bomb_likelihood, seed);
+		apply_move(game, Opcode::Reveal, {i, j});
+
+		std::set<std::pair<int, int>> expected = expected_opening(seed, bomb_likelihood, i, j);
+		std::set<std::pair<int, int>> revealed(game.last_revealed.begin(), game.last_revealed.end());
+		std::string name = "seed " + std::to_string(seed);
+		if (!expect(revealed == expected && game.count_revealed == expected.size(), "opening, " + name)) {
+			continue;
+		}
+
+		bool counted = true;
+		for (auto [a, b] : expected) {
+			counted &= game.is_revealed(a, b) && game.find_chunk(a, b) != nullptr;
+		}
+		expect(counted, "revealed cells, " + name);
+		expect(game.count_chunks() == chunks_of(game.last_revealed).size(), "chunks materialized, " + name);
+	}
+}
+
+// a cascade stops once cascade_limit cells are revealed, and chording a cell it left on its edge
+// carries on from there
+void cascade_limit() {
+	for (size_t limit : {size_t(1), size_t(50), size_t(4096), size_t(20000)}) {
+		EndlessGame game(0, 1);
+		game.cascade_limit = limit;
+		apply_move(game, Opcode::Reveal, {0, 0});
+		size_t revealed = game.last_revealed.size();
+		// the step that reaches the limit spreads to at most four cells
+		std::string name = "limit " + std::to_string(limit);
+		expect(revealed >= limit && revealed < limit + 4 && game.count_revealed == revealed, "cut-off, " + name);
+		expect(game.count_chunks() == chunks_of(game.last_revealed).size(), "chunks after a cut-off, " + name);
+
+		// the last cell revealed had yet to spread
+		auto edge = game.last_revealed.back();
+		apply_move(game, Opcode::Chord, edge);
+		expect(!game.last_revealed.empty() && game.count_revealed > revealed, "chord after the cut-off, " + name);
+	}
+}
+
+// the board ends one cell short of the int limits, and no cascade reaches past it
+void limits() {
+	struct Corner {
+		int i;
+		int j;
+	};
+
+	for (Corner corner : {Corner{int_max - 1, int_max - 1}, Corner{int_min + 1, int_min + 1}, Corner{int_max - 1, int_min + 1},
+		Corner{int_min + 1, 0}, Corner{0, int_max - 1}}) {
+		std::string name = std::to_string(corner.i) + ", " + std::to_string(corner.j);
+		EndlessGame game(0, 3);
+		game.cascade_limit = 5000;
+		expect(apply_move(game, Opcode::Reveal, {corner.i, corner.j}) == PlayerMove::Success && game.last_revealed.size() >= 5000,
+			"reveal at " + name);
+
+		bool inside = true;
+		for (auto [a, b] : game.last_revealed) {
+			inside &= !EndlessGame::outside(a, b);
+		}
+		expect(inside, "cascade at " + name);
+		expect(game.count_chunks() == chunks_of(game.last_revealed).size(), "chunks at " + name);
+
+		// the neighbours of the corner that are on the board take flags unless revealed
+		uint64_t flags = 0;
+		for_each_neighbor<dir8>(0, 0, [&](int di, int dj) {
+			int64_t a = int64_t(corner.i) + di;
+			int64_t b = int64_t(corner.j) + dj;
+			if (EndlessGame::outside(a, b)) {
+				return;
+			}
+
+			int c = static_cast<int>(a);
+			int d = static_cast<int>(b);
+			bool hidden = !game.is_revealed(c, d);
+			flags += hidden;
+			expect(apply_move(game, Opcode::Flag, {c, d}) == (hidden ? PlayerMove::Success : PlayerMove::NA), "flag next to " + name);
+		});
+		expect(game.count_flagged == flags, "flags at " + name);
+	}
+
+	EndlessGame game(.2f, 5);
+	for (int i : {int_min, int_max}) {
+		expect(apply_move(game, Opcode::Reveal, {i, 0}) == PlayerMove::OutBounds && apply_move(game, Opcode::Reveal, {0, i}) == PlayerMove::OutBounds
+			&& apply_move(game, Opcode::Flag, {i, i}) == PlayerMove::OutBounds, "moves on the int limit " + std::to_string(i));
+	}
+	expect(game.count_chunks() == 0 && game.first_move, "moves off the board write nothing");
+}
+
+const Register openings_case("endless_openings", openings);
+const Register cascade_limit_case("endless_cascade_limit", cascade_limit);
+const Register limits_case("endless_limits", limits);
+
+}
+
+}
@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fixed_game.hpp"
+#include "game.hpp"
+#include "protocol.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+template <size_t R, size_t C, typename Topo>
+void fixed_game_matches_game(uint64_t games) {
+	for (uint64_t seed = 0; seed < games; seed++) {
+		Game game(R, C, .15f, seed);
+		game.topology = Topo::kind;
+		FixedGame<R, C, Topo> fixed(.15f, seed);
+		uint64_t rng = seed;
+		for (int move = 0; move < 300 && game.state != GameState::OVER; move++) {
+			auto [op, place] = random_move(rng, R, C);
+			PlayerMove expected = apply_move(game, op, place);
+			PlayerMove actual = apply_move(fixed, op, place);
+
+			std::vector<uint32_t> cells(fixed.last_revealed.begin(), fixed.last_revealed.begin() + fixed.last_revealed_size);
+			std::sort(cells.begin(), cells.end());
+			bool same = expected == actual && cells == sorted_revealed(game) && fixed.state == game.state
+				&& fixed.count_bombs == game.count_bombs && fixed.count_flagged == game.count_flagged
+				&& fixed.count_correct_flags == game.count_correct_flags && fixed.count_revealed == game.count_revealed;
+			if (!expect(same, "FixedGame<" + std::to_string(R) + ", " + std::to_string(C) + ">, " + topology_names[static_cast<size_t>(Topo::kind)] + ", " + seed_name(seed, move))) {
+				return;
+			}
+		}
+	}
+}
+
+void fixed_game() {
+	fixed_game_matches_game<9, 9, Rectangle>(1000);
+	fixed_game_matches_game<16, 30, Rectangle>(300);
+	fixed_game_matches_game<16, 16, Torus>(300);
+	fixed_game_matches_game<9, 9, Hex>(1000);
+}
+
+const Register fixed_game_case("fixed_game", fixed_game);
+
+}
+
+}
@@ -0,0 +1,51 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "flood.hpp"
+#include "game.hpp"
+#include "protocol.hpp"
+#include "replay.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+void flood() {
+	size_t handoff = flood_handoff;
+	unsigned threads = flood_threads;
+	flood_handoff = 16;
+
+	for (Topology topology : {Topology::Rectangle, Topology::Torus, Topology::Hex}) {
+		for (uint64_t seed = 0; seed < 20; seed++) {
+			Game serial(120, 150, .08f, seed);
+			Game parallel(120, 150, .08f, seed);
+			serial.topology = parallel.topology = topology;
+			uint64_t rng = seed;
+			for (int move = 0; move < 60 && serial.state != GameState::OVER; move++) {
+				auto [op, place] = random_move(rng, 120, 150);
+				flood_threads = 1;
+				PlayerMove expected = apply_move(serial, op, place);
+				flood_threads = 4;
+				PlayerMove actual = apply_move(parallel, op, place);
+
+				bool same = expected == actual && sorted_revealed(serial) == sorted_revealed(parallel)
+					&& hash_state(serial) == hash_state(parallel) && serial.state == parallel.state;
+				if (!expect(same, std::string(topology_names[static_cast<size_t>(topology)]) + ", " + seed_name(seed, move))) {
+					break;
+				}
+			}
+		}
+	}
+
+	flood_handoff = handoff;
+	flood_threads = threads;
+}
+
+const Register flood_case("flood", flood);
+
+}
+
+}
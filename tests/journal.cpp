@@ -0,0 +1,64 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "game.hpp"
+#include "journal.hpp"
+#include "protocol.hpp"
+#include "replay.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+void undo_redo() {
+	for (uint64_t seed = 0; seed < 200; seed++) {
+		Journal journal(size_t(1) << 24);
+		Game game(12, 14, .15f, seed);
+		game.topology = static_cast<Topology>(seed % 3);
+		game.journal = &journal;
+
+		// the state before every move that was journaled
+		std::vector<uint64_t> states;
+		uint64_t rng = seed;
+		for (int move = 0; move < 80 && game.state != GameState::OVER; move++) {
+			auto [op, place] = random_move(rng, 12, 14);
+			if (op == Opcode::Restart) {
+				continue;
+			}
+
+			uint64_t before = hash_state(game);
+			size_t done = journal.done.size();
+			apply_move(game, op, place);
+			if (journal.done.size() > done) {
+				states.push_back(before);
+			}
+		}
+		states.push_back(hash_state(game));
+
+		bool round_trip = true;
+		for (size_t k = states.size() - 1; k > 0; k--) {
+			round_trip &= apply_move(game, Opcode::Undo, {0, 0}) == PlayerMove::Success;
+			round_trip &= hash_state(game) == states[k - 1] && counters_consistent(game);
+		}
+		round_trip &= apply_move(game, Opcode::Undo, {0, 0}) == PlayerMove::NA;
+		expect(round_trip, "undo, seed " + std::to_string(seed));
+
+		round_trip = true;
+		for (size_t k = 1; k < states.size(); k++) {
+			round_trip &= apply_move(game, Opcode::Redo, {0, 0}) == PlayerMove::Success;
+			round_trip &= hash_state(game) == states[k] && counters_consistent(game);
+		}
+		round_trip &= apply_move(game, Opcode::Redo, {0, 0}) == PlayerMove::NA;
+		expect(round_trip, "redo, seed " + std::to_string(seed));
+	}
+}
+
+const Register undo_redo_case("undo_redo", undo_redo);
+
+}
+
+}
@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "board_memory.hpp"
+#include "flood.hpp"
+#include "game.hpp"
+#include "protocol.hpp"
+#include "replay.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+// plays the same moves on both layouts, the tiled game with the band-parallel fill and the
+// parallel flood, and compares every result, cascade and counter, and the cells every few moves
+void same_games(size_t m, size_t n, float bomb_likelihood, uint64_t games, int moves) {
+	for (Topology topology : {Topology::Rectangle, Topology::Torus, Topology::Hex}) {
+		for (uint64_t seed = 0; seed < games; seed++) {
+			std::string name = std::to_string(m) + "x" + std::to_string(n) + ", "
+				+ topology_names[static_cast<size_t>(topology)] + ", seed " + std::to_string(seed);
+
+			fill_threads = 1;
+			flood_threads = 1;
+			Game rows(m, n, bomb_likelihood, seed, Layout::RowMajor);
+			fill_threads = 4;
+			Game tiled(m, n, bomb_likelihood, seed, Layout::Tiled);
+			rows.set_topology(topology);
+			tiled.set_topology(topology);
+			if (!expect(hash_state(rows) == hash_state(tiled) && rows.count_bombs == tiled.count_bombs, "filled board, " + name)) {
+				continue;
+			}
+
+			uint64_t rng = seed;
+			for (int move = 0; move < moves && rows.state != GameState::OVER; move++) {
+				auto [op, place] = random_move(rng, m, n);
+				flood_threads = 1;
+				PlayerMove expected = apply_move(rows, op, place);
+				flood_threads = 4;
+				PlayerMove actual = apply_move(tiled, op, place);
+
+				bool same = expected == actual && sorted_revealed(rows) == sorted_revealed(tiled) && rows.state == tiled.state
+					&& rows.count_flagged == tiled.count_flagged && rows.count_correct_flags == tiled.count_correct_flags
+					&& rows.count_revealed == tiled.count_revealed && rows.count_bombs == tiled.count_bombs;
+				if (move % 8 == 0 || rows.state == GameState::OVER) {
+					same &= hash_state(rows) == hash_state(tiled);
+				}
+				if (!expect(same, name + ", move " + std::to_string(move))) {
+					break;
+				}
+			}
+		}
+	}
+}
+
+void layouts() {
+	unsigned threads = fill_threads;
+	size_t cells = parallel_fill_cells;
+	unsigned flood = flood_threads;
+	size_t handoff = flood_handoff;
+	parallel_fill_cells = 64;
+	flood_handoff = 64;
+
+	// sizes on either side of the 8x8 tiles, and a board that ends inside a tile both ways
+	same_games(9, 13, .15f, 40, 80);
+	same_games(13, 9, .15f, 40, 80);
+	same_games(8, 8, .12f, 20, 60);
+	same_games(3, 64, .1f, 20, 60);
+	same_games(65, 3, .1f, 20, 60);
+	same_games(1100, 1030, .06f, 1, 40);
+
+	fill_threads = threads;
+	parallel_fill_cells = cells;
+	flood_threads = flood;
+	flood_handoff = handoff;
+}
+
+const Register layouts_case("layouts", layouts);
+
+}
+
+}
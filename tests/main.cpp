@@ -0,0 +1,13 @@
+#include <iostream>
+
+#include "check.hpp"
+
+int main() {
+	for (auto& test : tests::cases()) {
+		size_t before = tests::failures;
+		test.run();
+		std::cout << (tests::failures == before ? "ok      " : "FAILED  ") << test.name << std::endl;
+	}
+
+	return tests::failures ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "game.hpp"
+#include "metrics.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+// the clicks that clear the board: first every zero cell still hidden, each opening its region,
+// then every safe cell that no opening revealed
+uint32_t count_clicks(Game game) {
+	game.first_move = false;
+	uint32_t clicks = 0;
+	for (int zeros = 1; zeros >= 0; zeros--) {
+		for (size_t i = 0; i < game.grid.rows(); i++) {
+			for (size_t j = 0; j < game.grid.cols(); j++) {
+				bool zero = count_bomb_neighbors(game, i, j) == 0;
+				if (!game.is_bomb(i, j) && !game.is_revealed(i, j) && (zero || !zeros)) {
+					try_reveal(game, {static_cast<int>(i), static_cast<int>(j)});
+					clicks++;
+				}
+			}
+		}
+	}
+
+	return clicks;
+}
+
+void metrics() {
+	for (uint64_t seed = 0; seed < 500; seed++) {
+		size_t m = 1 + seed % 23;
+		size_t n = 1 + seed / 23 % 31;
+		Game game(m, n, .05f + (seed % 7) * .05f, seed);
+		BoardMetrics metrics = compute_metrics(game);
+		uint32_t clicks = count_clicks(game);
+		expect(metrics.bbbv == clicks, "3bv " + std::to_string(metrics.bbbv) + " against " + std::to_string(clicks) + " clicks, "
+			+ std::to_string(m) + "x" + std::to_string(n) + " seed " + std::to_string(seed));
+	}
+}
+
+const Register metrics_case("metrics", metrics);
+
+}
+
+}
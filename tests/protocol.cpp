@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "game.hpp"
+#include "protocol.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+void moves() {
+	uint64_t rng = 1;
+	std::string frames;
+	std::vector<std::pair<Opcode, std::pair<int, int>>> sent;
+	for (int k = 0; k < 2000; k++) {
+		rng = mix64(rng);
+		// every varint length, up to the largest coordinate
+		int shift = rng % 31;
+		std::pair<int, int> place = {static_cast<int>((rng >> 32) & ((1u << shift) - 1)), static_cast<int>(rng >> 40 & 0x7fffff)};
+		Opcode op = static_cast<Opcode>(1 + (rng >> 8) % 7);
+		encode_move(frames, op, place);
+		sent.push_back({op, place});
+	}
+	encode_move(frames, Opcode::Reveal, {0x7fffffff, 0x7fffffff});
+	sent.push_back({Opcode::Reveal, {0x7fffffff, 0x7fffffff}});
+
+	std::istringstream is(frames);
+	Opcode op;
+	std::pair<int, int> place;
+	for (auto& expected : sent) {
+		if (!expect(decode_move(is, op, place) && op == expected.first && place == expected.second, "decoding move " + std::to_string(place.first))) {
+			return;
+		}
+	}
+	expect(!decode_move(is, op, place), "decoding past the last frame");
+
+	// a frame cut short is not a move
+	std::string cut;
+	encode_move(cut, Opcode::Flag, {300, 70000});
+	for (size_t size = 0; size < cut.size(); size++) {
+		std::istringstream part(cut.substr(0, size));
+		expect(!decode_move(part, op, place), "decoding a frame of " + std::to_string(size) + " bytes");
+	}
+}
+
+void spans() {
+	for (uint64_t seed = 0; seed < 500; seed++) {
+		uint64_t rng = seed;
+		std::pmr::vector<uint32_t> cells;
+		uint32_t cell = 0;
+		for (int k = 0; k < static_cast<int>(seed % 200); k++) {
+			rng = mix64(rng);
+			// runs of neighbouring cells with gaps of every varint length between them
+			cell += rng % 4 ? 1 : 1 + (rng >> 8) % (uint32_t(1) << (rng >> 16) % 22);
+			cells.push_back(cell);
+		}
+		std::vector<uint32_t> expected(cells.begin(), cells.end());
+		std::reverse(cells.begin(), cells.end());
+
+		std::string out;
+		encode_spans(out, cells);
+		std::vector<uint32_t> decoded;
+		for_each_span_cell(out, [&decoded](uint32_t cell) {
+			decoded.push_back(cell);
+		});
+		expect(decoded == expected, "spans, seed " + std::to_string(seed));
+	}
+}
+
+struct Frame {
+	PlayerMove result;
+	GameState state;
+	std::vector<uint32_t> cells;
+
+	bool operator==(const Frame& other) const {
+		return result == other.result && state == other.state && cells == other.cells;
+	}
+};
+
+// takes one response off the front of in
+bool read_frame(std::string_view& in, Frame& frame) {
+	if (in.size() < 2) {
+		return false;
+	}
+
+	frame.result = static_cast<PlayerMove>(in[0]);
+	frame.state = static_cast<GameState>(in[1]);
+	in.remove_prefix(2);
+
+	std::string_view spans = in;
+	uint32_t count, gap, length;
+	if (!read_varint(in, count)) {
+		return false;
+	}
+	for (uint32_t s = 0; s < count; s++) {
+		if (!read_varint(in, gap) || !read_varint(in, length)) {
+			return false;
+		}
+	}
+
+	frame.cells.clear();
+	for_each_span_cell(spans.substr(0, spans.size() - in.size()), [&frame](uint32_t cell) {
+		frame.cells.push_back(cell);
+	});
+	return true;
+}
+
+// serve_binary answers every frame with what playing the move directly gives
+void serving() {
+	for (uint64_t seed = 0; seed < 50; seed++) {
+		Game served(9, 11, .15f, seed);
+		Game played(9, 11, .15f, seed);
+		served.topology = played.topology = static_cast<Topology>(seed % 3);
+
+		std::string frames;
+		std::vector<Frame> expected;
+		uint64_t rng = seed;
+		for (int move = 0; move < 80 && played.state != GameState::OVER; move++) {
+			auto [op, place] = random_move(rng, 9, 11);
+			encode_move(frames, op, place);
+			PlayerMove result = apply_move(played, op, place);
+			expected.push_back({result, played.state, sorted_revealed(played)});
+		}
+
+		std::istringstream is(frames);
+		std::ostringstream os;
+		serve_binary(served, is, os);
+
+		std::string out = os.str();
+		std::string_view in = out;
+		std::vector<Frame> answered;
+		Frame frame;
+		while (read_frame(in, frame)) {
+			answered.push_back(frame);
+		}
+		expect(in.empty() && answered == expected, "served frames, seed " + std::to_string(seed));
+	}
+}
+
+const Register moves_case("protocol_moves", moves);
+const Register spans_case("protocol_spans", spans);
+const Register serving_case("protocol_serving", serving);
+
+}
+
+}
@@ -0,0 +1,95 @@
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "game.hpp"
+#include "protocol.hpp"
+#include "render.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+// the glyph of a cell, as the per-cell printer wrote it before render replaced it
+std::string expected_glyph(const Game& game, int i, int j) {
+	if (game.is_flagged(i, j) || (is_won(game) && game.is_bomb(i, j))) {
+		return "\033[1;44mF\033[0m";
+	}
+
+	if (game.state != GameState::OVER && !game.is_revealed(i, j)) {
+		return ".";
+	}
+
+	if (game.is_bomb(i, j)) {
+		return "\033[30;41;1mB\033[0m";
+	}
+
+	uint32_t bombs = count_bomb_neighbors(game, i, j);
+	return bombs ? "\033[43;30;1m" + std::to_string(bombs) + "\033[0m" : "\033[47m \033[0m";
+}
+
+std::string expected_board(const Game& game) {
+	std::string out = "   ";
+	for (size_t j = 0; j < game.grid.cols(); j++) {
+		out += std::to_string(j) + ' ';
+	}
+	out += '\n';
+
+	for (size_t i = 0; i < game.grid.rows(); i++) {
+		out += std::to_string(i) + "  ";
+		if (game.topology == Topology::Hex && (i & 1)) {
+			out += ' ';
+		}
+		for (size_t j = 0; j < game.grid.cols(); j++) {
+			out += expected_glyph(game, i, j) + ' ';
+		}
+		out += '\n';
+	}
+
+	return out;
+}
+
+void rendering() {
+	for (Topology topology : {Topology::Rectangle, Topology::Torus, Topology::Hex}) {
+		for (uint64_t seed = 0; seed < 50; seed++) {
+			// sizes around the 16 cells of an ssse3 step
+			Game game(7 + seed % 5, 12 + seed % 9, .15f, seed);
+			game.topology = topology;
+			uint64_t rng = seed;
+			std::string name = std::string(topology_names[static_cast<size_t>(topology)]) + ", seed " + std::to_string(seed);
+			for (int move = 0; move < 40 && game.state != GameState::OVER; move++) {
+				auto [op, place] = random_move(rng, game.grid.rows(), game.grid.cols());
+				apply_move(game, op, place);
+				if (move % 8 == 0) {
+					std::ostringstream os;
+					render(os, game, RenderMode::Ansi);
+					expect(os.str() == expected_board(game), "ansi board, " + name);
+				}
+			}
+
+			std::ostringstream over;
+			render(over, game, RenderMode::Ansi);
+			expect(over.str() == expected_board(game), "ansi board after the game, " + name);
+
+			// a won board shows every bomb flagged
+			for (size_t i = 0; i < game.grid.rows(); i++) {
+				for (size_t j = 0; j < game.grid.cols(); j++) {
+					game.set_flagged(i, j, false);
+					game.set_revealed(i, j);
+				}
+			}
+			std::ostringstream won;
+			render(won, game, RenderMode::Ansi);
+			expect(won.str() == expected_board(game), "ansi won board, " + name);
+		}
+	}
+}
+
+const Register render_case("render", rendering);
+
+}
+
+}
@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "game.hpp"
+#include "journal.hpp"
+#include "protocol.hpp"
+#include "replay.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+// a game recorded through ReplayWriter replays to the same final state
+void round_trip() {
+	std::string log = temp_path("round_trip.log");
+	for (uint64_t seed = 0; seed < 100; seed++) {
+		Journal journal(size_t(1) << 20);
+		Game game(10 + seed % 7, 12 + seed % 5, .15f, seed);
+		game.set_topology(static_cast<Topology>(seed % 3));
+		if (seed % 2) {
+			game.journal = &journal;
+		}
+
+		size_t moves = 0;
+		{
+			ReplayWriter writer(log, game);
+			game.recorder = &writer;
+			uint64_t rng = seed;
+			for (int move = 0; move < 120 && game.state != GameState::OVER; move++, moves++) {
+				auto [op, place] = random_move(rng, game.grid.rows(), game.grid.cols());
+				rng = mix64(rng);
+				if (game.journal && rng % 8 == 0) {
+					op = rng % 16 ? Opcode::Undo : Opcode::Redo;
+				}
+				apply_move(game, op, place);
+			}
+			game.recorder = nullptr;
+			writer.finish(game);
+		}
+
+		ReplayResult result = replay(log);
+		expect(result.complete && result.matched && result.moves == moves, "replay, seed " + std::to_string(seed));
+	}
+
+	// the final hash is checked, not just read
+	std::fstream file(log, std::ios::binary | std::ios::in | std::ios::out);
+	file.seekg(-1, std::ios::end);
+	char last = file.get() ^ 1;
+	file.seekp(-1, std::ios::end);
+	file.put(last);
+	file.close();
+	ReplayResult result = replay(log);
+	expect(result.complete && !result.matched, "replay with a changed hash");
+	std::remove(log.c_str());
+}
+
+// a header naming a board that cannot be played is refused like a bad magic
+void bad_headers() {
+	struct Header {
+		const char* name;
+		uint32_t m;
+		uint32_t n;
+		uint32_t topology;
+	};
+
+	std::string log = temp_path("bad_header.log");
+	for (Header header : {Header{"a good header", 9, 9, 0}, Header{"no rows", 0, 9, 0}, Header{"no columns", 9, 0, 0},
+		Header{"too many cells", 1 << 20, 1 << 20, 0}, Header{"the largest varint", 0xffffffff, 0xffffffff, 2},
+		Header{"an unknown topology", 9, 9, 3}, Header{"a 2x9 torus", 2, 9, 1}}) {
+		std::string bytes(replay_magic, sizeof(replay_magic));
+		write_varint(bytes, header.m);
+		write_varint(bytes, header.n);
+		write_word(bytes, 1, 8);
+		float likelihood = .1f;
+		uint32_t bits;
+		std::memcpy(&bits, &likelihood, sizeof(bits));
+		write_word(bytes, bits, 4);
+		write_varint(bytes, 0);
+		write_varint(bytes, header.topology);
+		encode_move(bytes, Opcode::End, {0, 0});
+
+		Game game(9, 9, .1f, 1);
+		write_word(bytes, hash_state(game), 8);
+		bool good = header.m == 9 && header.n == 9 && header.topology == 0;
+		std::ofstream(log, std::ios::binary).write(bytes.data(), bytes.size());
+		ReplayResult result = replay(log);
+		expect(result.complete == good && result.matched == good, std::string("replaying ") + header.name);
+
+		// every prefix of the file is incomplete
+		if (good) {
+			for (size_t size = 0; size < bytes.size(); size++) {
+				std::ofstream(log, std::ios::binary | std::ios::trunc).write(bytes.data(), size);
+				expect(!replay(log).complete, "replaying " + std::to_string(size) + " bytes of a log");
+			}
+		}
+	}
+
+	std::string bytes = "MNRX";
+	std::ofstream(log, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+	expect(!replay(log).complete, "replaying a bad magic");
+	expect(!replay(temp_path("missing.log")).complete, "replaying a missing file");
+	std::remove(log.c_str());
+}
+
+const Register round_trip_case("replay_round_trip", round_trip);
+const Register bad_headers_case("replay_headers", bad_headers);
+
+}
+
+}
@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "game.hpp"
+#include "protocol.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+bool all_hidden(const Game& game) {
+	for (size_t i = 0; i < game.grid.rows(); i++) {
+		for (size_t j = 0; j < game.grid.cols(); j++) {
+			if (game.is_flagged(i, j) || game.is_revealed(i, j)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool reset(const Game& game, uint32_t bombs) {
+	return all_hidden(game) && game.count_flagged == 0 && game.count_correct_flags == 0 && game.count_revealed == 0
+		&& game.count_bombs == bombs && game.first_move && game.state == GameState::ACTIVE && counters_consistent(game);
+}
+
+// flags and reveals some cells, so that a restart has tags to hide
+void play(Game& game, uint64_t seed) {
+	uint64_t rng = seed;
+	for (int move = 0; move < 30 && game.state != GameState::OVER; move++) {
+		auto [op, place] = random_move(rng, game.grid.rows(), game.grid.cols());
+		if (op != Opcode::Restart) {
+			apply_move(game, op, place);
+		}
+	}
+	apply_move(game, Opcode::Flag, {0, 0});
+}
+
+void epochs() {
+	for (uint64_t seed = 0; seed < 50; seed++) {
+		Game game(9 + seed % 4, 11, .15f, seed, seed % 2 ? Layout::Tiled : Layout::RowMajor);
+		play(game, seed);
+		uint32_t bombs = game.count_bombs;
+		game.restart();
+		expect(game.epoch == 1 && reset(game, bombs), "restart, seed " + std::to_string(seed));
+
+		// the next game is played as on a fresh board
+		play(game, seed + 1);
+		expect(counters_consistent(game), "game after a restart, seed " + std::to_string(seed));
+	}
+
+	// cells tagged in epoch 0 and never touched again must not come back when the epoch wraps
+	// to 0, which is when restart clears them for real
+	Game game(16, 30, .15f, 1);
+	play(game, 1);
+	uint32_t bombs = game.count_bombs;
+	bool hidden = true;
+	for (uint32_t k = 0; k < 0x10000; k++) {
+		game.restart();
+		hidden &= game.count_revealed == 0 && game.count_flagged == 0;
+		if (game.epoch == 0 || game.epoch == 1 || game.epoch == 0xffff) {
+			hidden &= reset(game, bombs);
+		}
+	}
+	expect(hidden && game.epoch == 0 && reset(game, bombs), "restarts across the epoch wrap");
+
+	// and tags from the epoch just before the wrap are cleared too
+	play(game, 2);
+	game.epoch = 0xffff;
+	for (auto& cell : game.grid.storage()) {
+		if (cell.flagged || cell.revealed) {
+			cell.epoch = 0xffff;
+		}
+	}
+	game.restart();
+	expect(game.epoch == 0 && reset(game, game.count_bombs), "restart from the last epoch");
+	play(game, 3);
+	expect(counters_consistent(game), "game after the wrap");
+}
+
+// a new board of the same size is drawn into the cells already allocated
+void new_board() {
+	for (Layout layout : {Layout::RowMajor, Layout::Tiled}) {
+		Game game(40, 50, .15f, 1, layout);
+		const Cell* cells = game.grid.storage().begin();
+		for (uint64_t seed = 2; seed < 20; seed++) {
+			play(game, seed);
+			game.restart();
+			play(game, seed);
+			game.new_board(seed);
+
+			Game fresh(40, 50, .15f, seed, layout);
+			bool same = game.grid.storage().begin() == cells && game.epoch == 0 && reset(game, fresh.count_bombs);
+			for (size_t i = 0; i < 40; i++) {
+				for (size_t j = 0; j < 50; j++) {
+					same &= game.is_bomb(i, j) == fresh.is_bomb(i, j);
+				}
+			}
+			expect(same, std::string("new board, ") + layout_names[static_cast<size_t>(layout)] + ", seed " + std::to_string(seed));
+		}
+	}
+}
+
+const Register epochs_case("restart_epochs", epochs);
+const Register new_board_case("new_board", new_board);
+
+}
+
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "flood.hpp"
+#include "simulate.hpp"
+
+#include "check.hpp"
+
+// every global allocation of the test binary is counted, so that a case can tell whether some
+// code it runs went to the heap
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+
+}
+
+void* operator new(size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1)) {
+		return p;
+	}
+
+	throw std::bad_alloc();
+}
+
+// the memory resources of the standard library allocate through the aligned form
+void* operator new(size_t size, std::align_val_t align) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	size_t alignment = static_cast<size_t>(align);
+	if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+		return p;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+	std::free(p);
+}
+
+namespace tests {
+
+namespace {
+
+// the global allocations of playing games of preset
+uint64_t allocations_of(const Preset& preset, uint64_t games, Topology topology) {
+	uint64_t before = allocations.load();
+	simulate_preset(preset, games, 11, topology);
+	return allocations.load() - before;
+}
+
+// past the arenas a call sets up, the games, moves and frames of simulate_preset stay off the
+// heap: more games allocate no more than one. the parallel flood's workers allocate on their
+// own, so cascades stay serial
+void arenas() {
+	unsigned threads = flood_threads;
+	flood_threads = 1;
+	for (auto& preset : presets) {
+		for (Topology topology : {Topology::Rectangle, Topology::Torus, Topology::Hex}) {
+			std::string name = std::string(preset.name) + ", " + topology_names[static_cast<size_t>(topology)];
+			// the first call sets up the statics of the command table and the renderer
+			allocations_of(preset, 1, topology);
+			uint64_t one = allocations_of(preset, 1, topology);
+			uint64_t more = allocations_of(preset, 1 + std::max<uint64_t>(1, 40 / preset.games_divisor), topology);
+			expect(more == one, "allocations of " + name + ": " + std::to_string(one) + " for a game, " + std::to_string(more) + " for more");
+		}
+	}
+
+	flood_threads = threads;
+}
+
+const Register arenas_case("simulate_arenas", arenas);
+
+}
+
+}
@@ -0,0 +1,115 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "game.hpp"
+#include "protocol.hpp"
+#include "snapshot.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+bool same_game(const Game& a, const Game& b) {
+	if (a.grid.rows() != b.grid.rows() || a.grid.cols() != b.grid.cols()) {
+		return false;
+	}
+
+	for (size_t i = 0; i < a.grid.rows(); i++) {
+		for (size_t j = 0; j < a.grid.cols(); j++) {
+			if (a.is_bomb(i, j) != b.is_bomb(i, j) || a.is_flagged(i, j) != b.is_flagged(i, j) || a.is_revealed(i, j) != b.is_revealed(i, j)) {
+				return false;
+			}
+		}
+	}
+
+	return a.count_bombs == b.count_bombs && a.count_flagged == b.count_flagged && a.count_correct_flags == b.count_correct_flags
+		&& a.count_revealed == b.count_revealed && a.first_move == b.first_move && a.state == b.state && a.topology == b.topology
+		&& a.seed == b.seed && a.bomb_likelihood == b.bomb_likelihood;
+}
+
+// a saved game loads back cell for cell, in either layout
+void round_trip() {
+	std::string path = temp_path("round_trip.snap");
+	for (uint64_t seed = 0; seed < 100; seed++) {
+		// sizes on either side of the 64 cells of a plane word
+		size_t m = 3 + seed % 9;
+		size_t n = 3 + seed * 7 % 70;
+		Game game(m, n, .12f, seed, seed % 2 ? Layout::Tiled : Layout::RowMajor);
+		game.set_topology(static_cast<Topology>(seed % 3));
+		uint64_t rng = seed;
+		int moves = seed % 40;
+		for (int move = 0; move < moves && game.state != GameState::OVER; move++) {
+			auto [op, place] = random_move(rng, m, n);
+			apply_move(game, op, place);
+		}
+
+		SnapshotView view;
+		if (!expect(save_snapshot(game, path) && view.open(path), "saving, seed " + std::to_string(seed))) {
+			continue;
+		}
+		expect(same_game(game, load_snapshot(view)) && same_game(game, load_snapshot(view, Layout::Tiled)), "loading, seed " + std::to_string(seed));
+	}
+	std::remove(path.c_str());
+}
+
+// a file whose header does not describe its planes is refused
+void bad_files() {
+	std::string path = temp_path("bad.snap");
+	Game game(9, 70, .15f, 3);
+	apply_move(game, Opcode::Reveal, {4, 4});
+	apply_move(game, Opcode::Flag, {0, 0});
+	save_snapshot(game, path);
+
+	std::string bytes;
+	{
+		std::ifstream in(path, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	SnapshotHeader good;
+	std::memcpy(&good, bytes.data(), sizeof(good));
+
+	auto opens = [&](const std::string& file) {
+		std::ofstream(path, std::ios::binary | std::ios::trunc).write(file.data(), file.size());
+		SnapshotView view;
+		return view.open(path);
+	};
+
+	expect(opens(bytes), "the saved file");
+	for (size_t size : {size_t(0), size_t(1), sizeof(SnapshotHeader) - 1, sizeof(SnapshotHeader), bytes.size() - 8, bytes.size() - 1}) {
+		expect(!opens(bytes.substr(0, size)), "a file cut to " + std::to_string(size) + " bytes");
+	}
+
+	auto with = [&](auto change) {
+		SnapshotHeader header = good;
+		change(header);
+		std::string file = bytes;
+		std::memcpy(file.data(), &header, sizeof(header));
+		return opens(file);
+	};
+
+	expect(!with([](SnapshotHeader& h) { h.magic[3] = 'X'; }), "a bad magic");
+	expect(!with([](SnapshotHeader& h) { h.words_per_plane--; }), "too few words per plane");
+	expect(!with([](SnapshotHeader& h) { h.words_per_plane++; }), "too many words per plane");
+	expect(!with([](SnapshotHeader& h) { h.words_per_plane = uint64_t(1) << 62; }), "a huge words per plane");
+	expect(!with([](SnapshotHeader& h) { h.rows = 0; }), "no rows");
+	expect(!with([](SnapshotHeader& h) { h.rows = h.cols = 0xffffffff; h.words_per_plane = (uint64_t(0xffffffff) * 0xffffffff + 63) / 64; }), "too many cells");
+	expect(!with([](SnapshotHeader& h) { h.topology = 3; }), "an unknown topology");
+	expect(!with([](SnapshotHeader& h) { h.state = 2; }), "an unknown state");
+	expect(!with([](SnapshotHeader& h) { h.first_move = 2; }), "a bad first_move");
+	expect(with([](SnapshotHeader& h) { h.topology = static_cast<uint8_t>(Topology::Torus); }), "a torus");
+	std::remove(path.c_str());
+}
+
+const Register round_trip_case("snapshot_round_trip", round_trip);
+const Register bad_files_case("snapshot_files", bad_files);
+
+}
+
+}
@@ -0,0 +1,58 @@
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+#include "game.hpp"
+#include "protocol.hpp"
+#include "replay.hpp"
+#include "snapshot.hpp"
+
+#include "check.hpp"
+
+namespace tests {
+
+namespace {
+
+// a torus narrower than 3 cells is refused by the engine and by every loader
+void small_torus() {
+	for (size_t m = 1; m <= 4; m++) {
+		for (size_t n = 1; n <= 4; n++) {
+			std::string name = std::to_string(m) + "x" + std::to_string(n);
+			bool torus = m >= 3 && n >= 3;
+			expect(fits(Topology::Rectangle, m, n) && fits(Topology::Hex, m, n) && fits(Topology::Torus, m, n) == torus, "fits, " + name);
+
+			Game game(m, n, .2f, m * 10 + n);
+			game.set_topology(Topology::Hex);
+			expect(game.set_topology(Topology::Torus) == torus && game.topology == (torus ? Topology::Torus : Topology::Hex), "set_topology, " + name);
+			if (torus) {
+				continue;
+			}
+
+			// files written from a board forced onto the torus, as a hand-made file could be
+			game.topology = Topology::Torus;
+			std::string log = temp_path("small_torus.log");
+			{
+				ReplayWriter writer(log, game);
+				writer.finish(game);
+			}
+			expect(!replay(log).complete, "replaying a torus, " + name);
+
+			std::string snapshot = temp_path("small_torus.snap");
+			SnapshotView view;
+			expect(save_snapshot(game, snapshot) && !view.open(snapshot), "loading a torus snapshot, " + name);
+			std::remove(log.c_str());
+			std::remove(snapshot.c_str());
+		}
+	}
+
+	// on the smallest torus every other cell is a neighbour, each seen once
+	Game game(3, 3, 1, 0);
+	expect(game.set_topology(Topology::Torus) && count_bomb_neighbors(game, 1, 1) == 8 && count_bomb_neighbors(game, 0, 0) == 8,
+		"neighbours on a 3x3 torus");
+}
+
+const Register small_torus_case("small_torus", small_torus);
+
+}
+
+}